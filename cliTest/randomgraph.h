@@ -0,0 +1,39 @@
+// SPDX-FileCopyrightText: 2026 depthmapX authors
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#pragma once
+
+#include "depthmapXcli/csrgraph.h"
+
+#include <random>
+#include <utility>
+#include <vector>
+
+// Undirected and connected, with random small integer weights so that there
+// are ties between paths
+inline depthmapX::CsrGraph makeRandomGraph(size_t numNodes, size_t numEdges, unsigned int seed) {
+    std::mt19937 generator(seed);
+    std::vector<std::vector<std::pair<size_t, float>>> edges(numNodes);
+    for (size_t i = 1; i < numNodes; i++) {
+        // a spanning tree so that everything is reached
+        size_t other = generator() % i;
+        auto weight = static_cast<float>(1 + generator() % 3);
+        edges[i].push_back({other, weight});
+        edges[other].push_back({i, weight});
+    }
+    for (size_t e = 0; e < numEdges; e++) {
+        size_t a = generator() % numNodes;
+        size_t b = generator() % numNodes;
+        if (a != b) {
+            auto weight = static_cast<float>(1 + generator() % 3);
+            edges[a].push_back({b, weight});
+            edges[b].push_back({a, weight});
+        }
+    }
+    depthmapX::CsrGraph graph;
+    for (const auto &nodeEdges : edges) {
+        graph.addNode(nodeEdges);
+    }
+    return graph;
+}
@@ -22,6 +22,9 @@ TEST_CASE("Test mode and help") {
         "-aa -af -au -ax\n"
         " Further flags for axial analysis are:\n"
         "   -xac Include choice (betweenness)\n"
+        "   -xacb Include choice computed in the cli by Brandes accumulation over all\n"
+        "         ordered pairs (radius n only, paths of equal depth share each pair),\n"
+        "         as Choice [Brandes]\n"
         "   -xal Include local measures\n"
         "   -xar Include RA, RRA and total depth\n"
         "   -xaw <map attribute name> perform weighted analysis using this attribute\n"
@@ -93,6 +96,15 @@ TEST_CASE("Test mode parsing", "") {
         REQUIRE(parser.runAnalysis());
         REQUIRE_FALSE(parser.calculateRRA());
         REQUIRE(parser.useChoice());
+        REQUIRE_FALSE(parser.useBrandesChoice());
+        REQUIRE_FALSE(parser.useLocal());
+    }
+    SECTION("Analysis + Brandes choice") {
+        ArgumentHolder ah{"prog", "-xa", "n", "-xacb"};
+        parser.parse(ah.argc(), ah.argv());
+        REQUIRE(parser.runAnalysis());
+        REQUIRE(parser.useChoice());
+        REQUIRE(parser.useBrandesChoice());
         REQUIRE_FALSE(parser.useLocal());
     }
     SECTION("Analysis + local") {
@@ -0,0 +1,199 @@
+// SPDX-FileCopyrightText: 2026 depthmapX authors
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "randomgraph.h"
+
+#include "depthmapXcli/brandeschoice.h"
+
+#include "catch_amalgamated.hpp"
+
+#include <algorithm>
+#include <limits>
+
+namespace {
+    typedef std::vector<std::pair<size_t, float>> Edges;
+
+    // all pairs distances and shortest path counts by Floyd-Warshall
+    struct AllPairs {
+        std::vector<std::vector<double>> dist;
+        std::vector<std::vector<double>> count;
+    };
+
+    AllPairs allPairs(const depthmapX::CsrGraph &graph) {
+        size_t n = graph.numNodes();
+        AllPairs result;
+        result.dist.assign(n, std::vector<double>(n, std::numeric_limits<double>::infinity()));
+        for (size_t i = 0; i < n; i++) {
+            result.dist[i][i] = 0;
+            for (size_t e = graph.offsets[i]; e < graph.offsets[i + 1]; e++) {
+                result.dist[i][graph.targets[e]] = std::min(
+                    result.dist[i][graph.targets[e]], static_cast<double>(graph.weights[e]));
+            }
+        }
+        for (size_t k = 0; k < n; k++) {
+            for (size_t i = 0; i < n; i++) {
+                for (size_t j = 0; j < n; j++) {
+                    result.dist[i][j] =
+                        std::min(result.dist[i][j], result.dist[i][k] + result.dist[k][j]);
+                }
+            }
+        }
+        // paths counted by their last edge, in order of distance
+        result.count.assign(n, std::vector<double>(n, 0));
+        for (size_t s = 0; s < n; s++) {
+            std::vector<size_t> order(n);
+            for (size_t i = 0; i < n; i++) {
+                order[i] = i;
+            }
+            std::sort(order.begin(), order.end(),
+                      [&](size_t a, size_t b) { return result.dist[s][a] < result.dist[s][b]; });
+            result.count[s][s] = 1;
+            for (size_t v : order) {
+                for (size_t e = graph.offsets[v]; e < graph.offsets[v + 1]; e++) {
+                    size_t w = graph.targets[e];
+                    if (result.dist[s][v] + static_cast<double>(graph.weights[e]) ==
+                        result.dist[s][w]) {
+                        result.count[s][w] += result.count[s][v];
+                    }
+                }
+            }
+        }
+        return result;
+    }
+
+    double dependency(const AllPairs &pairs, size_t s, size_t v) {
+        double total = 0;
+        for (size_t t = 0; t < pairs.dist.size(); t++) {
+            if (t != s && t != v && v != s &&
+                pairs.dist[s][v] + pairs.dist[v][t] == pairs.dist[s][t]) {
+                total += pairs.count[s][v] * pairs.count[v][t] / pairs.count[s][t];
+            }
+        }
+        return total;
+    }
+} // namespace
+
+TEST_CASE("Dependencies agree with all pairs shortest paths") {
+    auto graph = makeRandomGraph(40, 60, 3);
+    auto pairs = allPairs(graph);
+    depthmapX::DependencySearch search(graph, 1);
+    std::vector<double> dependencies;
+    for (size_t s = 0; s < graph.numNodes(); s++) {
+        search.run(s, dependencies);
+        REQUIRE(dependencies.size() == graph.numNodes());
+        for (size_t v = 0; v < graph.numNodes(); v++) {
+            REQUIRE(dependencies[v] == Catch::Approx(dependency(pairs, s, v)).margin(1e-9));
+        }
+    }
+}
+
+TEST_CASE("Dependencies of elements of two nodes") {
+    // elements 0, 1 and 2 in a row, each of a forwards and a backwards node,
+    // with a free turn from the far end of element 0 into element 2 that is
+    // as short as the way through element 1
+    depthmapX::CsrGraph graph;
+    graph.addNode(Edges{{2, 1.0f}, {4, 2.0f}});
+    graph.addNode(Edges{});
+    graph.addNode(Edges{{4, 1.0f}});
+    graph.addNode(Edges{{1, 1.0f}});
+    graph.addNode(Edges{});
+    graph.addNode(Edges{{3, 1.0f}});
+    depthmapX::DependencySearch search(graph, 2);
+    std::vector<double> dependencies;
+
+    search.run(0, dependencies);
+    REQUIRE(dependencies == std::vector<double>{0, 0.5, 0});
+    search.run(2, dependencies);
+    REQUIRE(dependencies == std::vector<double>{0, 1, 0});
+    search.run(1, dependencies);
+    REQUIRE(dependencies == std::vector<double>{0, 0, 0});
+}
+
+TEST_CASE("Choice over all pairs") {
+    auto graph = makeRandomGraph(50, 70, 4);
+    auto pairs = allPairs(graph);
+    auto choice = depthmapX::brandesChoice(graph, 1);
+    REQUIRE(choice.size() == graph.numNodes());
+    for (size_t v = 0; v < graph.numNodes(); v++) {
+        double expected = 0;
+        for (size_t s = 0; s < graph.numNodes(); s++) {
+            expected += dependency(pairs, s, v);
+        }
+        REQUIRE(choice[v] == Catch::Approx(expected).margin(1e-9));
+    }
+}
+
+TEST_CASE("Unweighted choice agrees with choice of unit weights") {
+    auto unitWeights = makeRandomGraph(60, 90, 6);
+    std::fill(unitWeights.weights.begin(), unitWeights.weights.end(), 1.0f);
+    auto unweighted = unitWeights;
+    unweighted.weights.clear();
+    for (size_t nodesPerElement : {size_t(1), size_t(2)}) {
+        auto expected = depthmapX::brandesChoice(unitWeights, nodesPerElement);
+        auto choice = depthmapX::brandesChoice(unweighted, nodesPerElement);
+        REQUIRE(choice.size() == expected.size());
+        for (size_t i = 0; i < expected.size(); i++) {
+            REQUIRE(choice[i] == Catch::Approx(expected[i]).margin(1e-9));
+        }
+    }
+}
+
+TEST_CASE("Turns in the same bin share the pairs") {
+    // two ways from element 0 to element 3, through element 1 or element 2,
+    // of the same whole number of bins, with one node per element
+    depthmapX::CsrGraph graph;
+    graph.addNode(Edges{{1, 3.0f}, {2, 1.0f}});
+    graph.addNode(Edges{{0, 3.0f}, {3, 1.0f}});
+    graph.addNode(Edges{{0, 1.0f}, {3, 3.0f}});
+    graph.addNode(Edges{{1, 1.0f}, {2, 3.0f}});
+    auto choice = depthmapX::brandesChoice(graph, 1);
+    // 0 to 3 and 3 to 0 are split evenly between 1 and 2, as are 1 to 2
+    // and 2 to 1 between 0 and 3
+    REQUIRE(choice == std::vector<double>{1, 1, 1, 1});
+}
+
+TEST_CASE("Paths go once round a cycle of no weight") {
+    // 0 enters the ring 1, 2, 3 of turns in the same bin at 1 and leaves it
+    // from 3 for 4, so the only way through is 1, 2, 3
+    depthmapX::CsrGraph graph;
+    graph.addNode(Edges{{1, 1.0f}});
+    graph.addNode(Edges{{2, 0.0f}});
+    graph.addNode(Edges{{3, 0.0f}});
+    graph.addNode(Edges{{1, 0.0f}, {4, 1.0f}});
+    graph.addNode(Edges{});
+    depthmapX::DependencySearch search(graph, 1);
+    std::vector<double> dependencies;
+    search.run(0, dependencies);
+    REQUIRE(dependencies == std::vector<double>{0, 3, 2, 1, 0});
+}
+
+TEST_CASE("Choice agrees with salalib on simple_axlines") {
+    // the connections of the lines of testdata/simple_axlines.graph and
+    // their choice as salalib writes it at radius n
+    const std::vector<std::vector<size_t>> connections = {
+        {1, 15}, {0, 2, 6}, {1, 3}, {2, 4},   {3, 5},   {4},  {1, 7},      {6, 8, 10}, {7, 9},
+        {8, 10}, {7, 9, 11}, {10},  {13},     {12, 16}, {15}, {0, 14, 16}, {13, 15}};
+    const std::vector<double> salalibChoice = {110, 168, 78, 56, 30, 0, 110, 97, 19,
+                                               3,   37,  0,  0,  30, 0, 102, 56};
+    depthmapX::CsrGraph graph;
+    for (const auto &lineConnections : connections) {
+        graph.addNode(lineConnections);
+    }
+    auto choice = depthmapX::brandesChoice(graph, 1);
+    REQUIRE(choice.size() == salalibChoice.size());
+    // lines 7, 8, 9 and 10 make a square with two ways of equal depth
+    // between opposite corners, where salalib follows one of them and the
+    // pairs here are shared between both, so only their sum agrees
+    double square = 0;
+    double salalibSquare = 0;
+    for (size_t i = 0; i < salalibChoice.size(); i++) {
+        if (i >= 7 && i <= 10) {
+            square += choice[i];
+            salalibSquare += salalibChoice[i];
+        } else {
+            REQUIRE(choice[i] == Catch::Approx(salalibChoice[i]));
+        }
+    }
+    REQUIRE(square == Catch::Approx(salalibSquare));
+}
@@ -0,0 +1,30 @@
+// SPDX-FileCopyrightText: 2026 depthmapX authors
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "depthmapXcli/cancellationtoken.h"
+
+#include "catch_amalgamated.hpp"
+
+TEST_CASE("CancellationToken") {
+    depthmapX::CancellationToken token;
+    REQUIRE_FALSE(token.isCancelled());
+    REQUIRE_FALSE(token.hasDeadline());
+
+    SECTION("Explicit cancellation") {
+        token.cancel();
+        REQUIRE(token.isCancelled());
+    }
+
+    SECTION("Deadline in the future") {
+        token.setTimeBudget(3600);
+        REQUIRE(token.hasDeadline());
+        REQUIRE_FALSE(token.isCancelled());
+    }
+
+    SECTION("Deadline passed") {
+        token.setDeadline(depthmapX::CancellationToken::Clock::now() - std::chrono::seconds(1));
+        REQUIRE(token.hasDeadline());
+        REQUIRE(token.isCancelled());
+    }
+}
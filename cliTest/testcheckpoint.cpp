@@ -0,0 +1,100 @@
+// SPDX-FileCopyrightText: 2026 depthmapX authors
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "depthmapXcli/checkpoint.h"
+
+#include "selfcleaningfile.h"
+
+#include "catch_amalgamated.hpp"
+
+#include <fstream>
+
+TEST_CASE("Checkpoint round trip") {
+    SelfCleaningFile file("test.checkpoint");
+    depthmapX::Checkpoint checkpoint("od metric 1 2,3 4,5", 4);
+    REQUIRE(checkpoint.numFinished() == 0);
+    checkpoint.finish(1, "12.5,1 7 3");
+    checkpoint.finish(3, "-1,");
+    checkpoint.write(file.Filename());
+    REQUIRE_FALSE(std::ifstream(file.Filename() + ".tmp").good());
+
+    depthmapX::Checkpoint resumed("od metric 1 2,3 4,5", 4);
+    resumed.resume(file.Filename());
+    REQUIRE(resumed.numFinished() == 2);
+    REQUIRE_FALSE(resumed.isFinished(0));
+    REQUIRE(resumed.isFinished(1));
+    REQUIRE(resumed.result(1) == "12.5,1 7 3");
+    REQUIRE_FALSE(resumed.isFinished(2));
+    REQUIRE(resumed.result(3) == "-1,");
+
+    // writing again replaces the previous checkpoint
+    resumed.finish(0, "4");
+    resumed.write(file.Filename());
+    depthmapX::Checkpoint again("od metric 1 2,3 4,5", 4);
+    again.resume(file.Filename());
+    REQUIRE(again.numFinished() == 3);
+    REQUIRE(again.result(0) == "4");
+}
+
+TEST_CASE("Checkpoint failures") {
+    SelfCleaningFile file("test.checkpoint");
+    depthmapX::Checkpoint checkpoint("key", 3);
+    checkpoint.finish(0, "1");
+
+    SECTION("Result with a line break") {
+        REQUIRE_THROWS_WITH(checkpoint.finish(1, "1\n2"),
+                            "Checkpoint results must fit on one line");
+    }
+
+    SECTION("Missing file") {
+        REQUIRE_THROWS_WITH(checkpoint.resume("nonexisting.checkpoint"),
+                            "Failed to open checkpoint nonexisting.checkpoint");
+    }
+
+    SECTION("Different key or number of records") {
+        checkpoint.write(file.Filename());
+        depthmapX::Checkpoint otherKey("other key", 3);
+        REQUIRE_THROWS_WITH(otherKey.resume(file.Filename()),
+                            "Checkpoint test.checkpoint was written by a different analysis or "
+                            "input");
+        depthmapX::Checkpoint otherSize("key", 4);
+        REQUIRE_THROWS_WITH(otherSize.resume(file.Filename()),
+                            "Checkpoint test.checkpoint was written by a different analysis or "
+                            "input");
+    }
+
+    SECTION("Broken files") {
+        checkpoint.write(file.Filename());
+        std::string content;
+        {
+            std::ifstream stream(file.Filename());
+            content.assign(std::istreambuf_iterator<char>(stream),
+                           std::istreambuf_iterator<char>());
+        }
+        std::string header = content.substr(0, content.find("0 1\n"));
+
+        {
+            std::ofstream stream(file.Filename());
+            stream << header << "0 1\n";
+        }
+        REQUIRE_THROWS_WITH(checkpoint.resume(file.Filename()),
+                            "Checkpoint test.checkpoint is incomplete");
+
+        {
+            std::ofstream stream(file.Filename());
+            stream << header << "3 1\nend\n";
+        }
+        REQUIRE_THROWS_WITH(checkpoint.resume(file.Filename()),
+                            "Invalid record in checkpoint test.checkpoint: 3 1");
+
+        {
+            std::ofstream stream(file.Filename());
+            stream << "something else\n";
+        }
+        REQUIRE_THROWS_WITH(checkpoint.resume(file.Filename()),
+                            "test.checkpoint is not a checkpoint");
+        // a failed resume leaves the results as they were
+        REQUIRE(checkpoint.numFinished() == 1);
+    }
+}
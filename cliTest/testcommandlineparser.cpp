@@ -90,6 +90,173 @@ TEST_CASE("Invalid Parser", "Constructor") {
         REQUIRE_THROWS_WITH(cmdP.parse(ah.argc(), ah.argv()), "-m requires an argument");
     }
 
+    {
+        CommandLineParser cmdP(factoryMock.get());
+        ArgumentHolder ah{"prog", "-tb", "-5"};
+        REQUIRE_THROWS_WITH(cmdP.parse(ah.argc(), ah.argv()),
+                            "-tb must be a positive number of seconds, got -5");
+    }
+
+    {
+        CommandLineParser cmdP(factoryMock.get());
+        ArgumentHolder ah{"prog", "-tb", "99999999999999999999"};
+        REQUIRE_THROWS_WITH(cmdP.parse(ah.argc(), ah.argv()),
+                            "-tb must be a positive number of seconds, got 99999999999999999999");
+    }
+
+    {
+        CommandLineParser cmdP(factoryMock.get());
+        ArgumentHolder ah{"prog", "-tb", "10000000000"};
+        REQUIRE_THROWS_WITH(cmdP.parse(ah.argc(), ah.argv()),
+                            "-tb must be a positive number of seconds, got 10000000000");
+    }
+
+    {
+        CommandLineParser cmdP(factoryMock.get());
+        ArgumentHolder ah{"prog", "-ck", "often"};
+        REQUIRE_THROWS_WITH(cmdP.parse(ah.argc(), ah.argv()),
+                            "-ck must be a positive number of seconds, got often");
+    }
+
+    {
+        CommandLineParser cmdP(factoryMock.get());
+        ArgumentHolder ah{"prog", "-ck", "99999999999999999999"};
+        REQUIRE_THROWS_WITH(cmdP.parse(ah.argc(), ah.argv()),
+                            "-ck must be a positive number of seconds, got 99999999999999999999");
+    }
+
+    {
+        CommandLineParser cmdP(factoryMock.get());
+        ArgumentHolder ah{"prog", "-rs"};
+        REQUIRE_THROWS_WITH(cmdP.parse(ah.argc(), ah.argv()), "-rs requires an argument");
+    }
+
+    {
+        CommandLineParser cmdP(factoryMock.get());
+        ArgumentHolder ah{"prog", "-or", "10:5"};
+        REQUIRE_THROWS_WITH(cmdP.parse(ah.argc(), ah.argv()),
+                            "-or must be given as <start>:<end> with start below end, got 10:5");
+    }
+
+    {
+        CommandLineParser cmdP(factoryMock.get());
+        ArgumentHolder ah{"prog", "-or", "10"};
+        REQUIRE_THROWS_WITH(cmdP.parse(ah.argc(), ah.argv()),
+                            "-or must be given as <start>:<end> with start below end, got 10");
+    }
+
+    {
+        CommandLineParser cmdP(factoryMock.get());
+        ArgumentHolder ah{"prog", "-or", "0:99999999999999999999"};
+        REQUIRE_THROWS_WITH(
+            cmdP.parse(ah.argc(), ah.argv()),
+            "-or must be given as <start>:<end> with start below end, got 0:99999999999999999999");
+    }
+
+    {
+        CommandLineParser cmdP(factoryMock.get());
+        ArgumentHolder ah{"prog", "-sv", "depthmapx.socket", "-svc", "0"};
+        REQUIRE_THROWS_WITH(cmdP.parse(ah.argc(), ah.argv()),
+                            "-svc must be a positive number of graphs, got 0");
+    }
+
+    {
+        CommandLineParser cmdP(factoryMock.get());
+        ArgumentHolder ah{"prog", "-sv", "depthmapx.socket", "-svc", "99999999999999999999"};
+        REQUIRE_THROWS_WITH(cmdP.parse(ah.argc(), ah.argv()),
+                            "-svc must be a positive number of graphs, got 99999999999999999999");
+    }
+
+    {
+        CommandLineParser cmdP(factoryMock.get());
+        ArgumentHolder ah{"prog", "-sa", "1.5"};
+        REQUIRE_THROWS_WITH(cmdP.parse(ah.argc(), ah.argv()),
+                            "-sa must be a fraction above 0 and up to 1, got 1.5");
+    }
+
+    {
+        CommandLineParser cmdP(factoryMock.get());
+        ArgumentHolder ah{"prog", "-sa", "0.1", "-sas", "-3"};
+        REQUIRE_THROWS_WITH(cmdP.parse(ah.argc(), ah.argv()),
+                            "-sas must be a non-negative 32 bit integer, got -3");
+    }
+
+    {
+        CommandLineParser cmdP(factoryMock.get());
+        ArgumentHolder ah{"prog", "-sa", "0.1", "-sas", "4294967296"};
+        REQUIRE_THROWS_WITH(cmdP.parse(ah.argc(), ah.argv()),
+                            "-sas must be a non-negative 32 bit integer, got 4294967296");
+    }
+
+    {
+        CommandLineParser cmdP(factoryMock.get());
+        ArgumentHolder ah{"prog", "-sa", "0.1", "-sas", "99999999999999999999"};
+        REQUIRE_THROWS_WITH(cmdP.parse(ah.argc(), ah.argv()),
+                            "-sas must be a non-negative 32 bit integer, got 99999999999999999999");
+    }
+
+    {
+        CommandLineParser cmdP(factoryMock.get());
+        ArgumentHolder ah{"prog", "-ml", "0"};
+        REQUIRE_THROWS_WITH(cmdP.parse(ah.argc(), ah.argv()),
+                            "-ml must be a positive number of MiB, got 0");
+    }
+
+    {
+        CommandLineParser cmdP(factoryMock.get());
+        ArgumentHolder ah{"prog", "-ml", ""};
+        REQUIRE_THROWS_WITH(cmdP.parse(ah.argc(), ah.argv()),
+                            "-ml must be a positive number of MiB, got ");
+    }
+
+    {
+        CommandLineParser cmdP(factoryMock.get());
+        ArgumentHolder ah{"prog", "-ml", "99999999999999999999"};
+        REQUIRE_THROWS_WITH(cmdP.parse(ah.argc(), ah.argv()),
+                            "-ml must be a positive number of MiB, got 99999999999999999999");
+    }
+
+    {
+        CommandLineParser cmdP(factoryMock.get());
+        ArgumentHolder ah{"prog", "-pj"};
+        REQUIRE_THROWS_WITH(cmdP.parse(ah.argc(), ah.argv()), "-pj requires an argument");
+    }
+
+    {
+        CommandLineParser cmdP(factoryMock.get());
+        ArgumentHolder ah{"prog", "-j"};
+        REQUIRE_THROWS_WITH(cmdP.parse(ah.argc(), ah.argv()), "-j requires an argument");
+    }
+
+    {
+        CommandLineParser cmdP(factoryMock.get());
+        ArgumentHolder ah{"prog", "-j", "0"};
+        REQUIRE_THROWS_WITH(cmdP.parse(ah.argc(), ah.argv()),
+                            "-j must be a positive integer, got 0");
+    }
+
+    {
+        CommandLineParser cmdP(factoryMock.get());
+        ArgumentHolder ah{"prog", "-j", "2.5"};
+        REQUIRE_THROWS_WITH(cmdP.parse(ah.argc(), ah.argv()),
+                            "-j must be a positive integer, got 2.5");
+    }
+
+    {
+        CommandLineParser cmdP(factoryMock.get());
+        ArgumentHolder ah{"prog", "-j", "99999999999999999999"};
+        REQUIRE_THROWS_WITH(cmdP.parse(ah.argc(), ah.argv()),
+                            "-j must be a positive integer, got 99999999999999999999");
+    }
+
+    {
+        CommandLineParser cmdP(factoryMock.get());
+        ArgumentHolder ah{"prog", "-j", "100000000"};
+        REQUIRE_THROWS_WITH(cmdP.parse(ah.argc(), ah.argv()),
+                            Catch::Matchers::StartsWith("-j must be at most ") &&
+                                Catch::Matchers::EndsWith(" threads, got 100000000"));
+    }
+
     {
         CommandLineParser cmdP(factoryMock.get());
         ArgumentHolder ah{"prog", "-m", "LaLaLa"};
@@ -154,6 +321,9 @@ TEST_CASE("Valid Parser", "CheckValues") {
         REQUIRE(cmdP.isValid());
         REQUIRE_FALSE(cmdP.simpleMode());
         REQUIRE(cmdP.getTimingFile().empty());
+        REQUIRE(cmdP.getNumThreads() == 0);
+        REQUIRE_FALSE(cmdP.printProgress());
+        REQUIRE(cmdP.getProgressFile().empty());
         REQUIRE(cmdP.modeOptions().getModeName() == "TEST1");
         REQUIRE(parsers[0]->getHelp() == TestParser::formatTestHelpString(false, true));
         REQUIRE(parsers[1]->getHelp() == TestParser::formatTestHelpString(false, false));
@@ -170,6 +340,98 @@ TEST_CASE("Valid Parser", "CheckValues") {
         REQUIRE(parsers[0]->getHelp() == TestParser::formatTestHelpString(false, true));
         REQUIRE(parsers[1]->getHelp() == TestParser::formatTestHelpString(false, false));
     }
+    SECTION("Parser test1 used, thread count") {
+        CommandLineParser cmdP(factoryMock.get());
+        ArgumentHolder ah{"prog", "-m", "TEST1", "-f", "inputfile.graph",
+                          "-o",   "outputfile.graph", "-j", "3"};
+        cmdP.parse(ah.argc(), ah.argv());
+        REQUIRE(cmdP.isValid());
+        REQUIRE(cmdP.getNumThreads() == 3);
+        REQUIRE(cmdP.getTimeBudget() == 0);
+    }
+    SECTION("Parser test1 used, time budget") {
+        CommandLineParser cmdP(factoryMock.get());
+        ArgumentHolder ah{"prog", "-m", "TEST1", "-f", "inputfile.graph",
+                          "-o",   "outputfile.graph", "-tb", "600"};
+        cmdP.parse(ah.argc(), ah.argv());
+        REQUIRE(cmdP.isValid());
+        REQUIRE(cmdP.getTimeBudget() == 600);
+        REQUIRE(cmdP.getCheckpointInterval() == 0);
+        REQUIRE(cmdP.getResumeFile().empty());
+    }
+    SECTION("Parser test1 used, checkpoints") {
+        CommandLineParser cmdP(factoryMock.get());
+        ArgumentHolder ah{"prog",
+                          "-m",
+                          "TEST1",
+                          "-f",
+                          "inputfile.graph",
+                          "-o",
+                          "outputfile.graph",
+                          "-ck",
+                          "300",
+                          "-rs",
+                          "outputfile.graph.checkpoint"};
+        cmdP.parse(ah.argc(), ah.argv());
+        REQUIRE(cmdP.isValid());
+        REQUIRE(cmdP.getCheckpointInterval() == 300);
+        REQUIRE(cmdP.getResumeFile() == "outputfile.graph.checkpoint");
+        REQUIRE_FALSE(cmdP.getOriginRange().has_value());
+    }
+    SECTION("Server mode") {
+        CommandLineParser cmdP(factoryMock.get());
+        ArgumentHolder ah{"prog", "-sv", "depthmapx.socket", "-svc", "8"};
+        cmdP.parse(ah.argc(), ah.argv());
+        REQUIRE_FALSE(cmdP.isValid());
+        REQUIRE(cmdP.getServeSocket() == "depthmapx.socket");
+        REQUIRE(cmdP.getServeCacheSize() == 8);
+    }
+    SECTION("Parser test1 used, origin range") {
+        CommandLineParser cmdP(factoryMock.get());
+        ArgumentHolder ah{"prog", "-m", "TEST1", "-f", "inputfile.graph",
+                          "-o",   "outputfile.graph", "-or", "100:200"};
+        cmdP.parse(ah.argc(), ah.argv());
+        REQUIRE(cmdP.isValid());
+        REQUIRE(cmdP.getOriginRange() == std::make_pair(size_t(100), size_t(200)));
+    }
+    SECTION("Parser test1 used, region of interest") {
+        CommandLineParser cmdP(factoryMock.get());
+        ArgumentHolder ah{"prog", "-m", "TEST1", "-f", "inputfile.graph",
+                          "-o",   "outputfile.graph", "-roi", "site.tsv"};
+        cmdP.parse(ah.argc(), ah.argv());
+        REQUIRE(cmdP.isValid());
+        REQUIRE(cmdP.getRegionOfInterestFile() == "site.tsv");
+    }
+    SECTION("Parser test1 used, sampling") {
+        CommandLineParser cmdP(factoryMock.get());
+        ArgumentHolder ah{"prog", "-m", "TEST1", "-f", "inputfile.graph", "-o", "outputfile.graph",
+                          "-sa",  "0.05", "-sas", "42"};
+        cmdP.parse(ah.argc(), ah.argv());
+        REQUIRE(cmdP.isValid());
+        REQUIRE(cmdP.getSampleFraction() == Catch::Approx(0.05));
+        REQUIRE(cmdP.getSampleSeed() == 42);
+    }
+    SECTION("Parser test1 used, progress file") {
+        CommandLineParser cmdP(factoryMock.get());
+        ArgumentHolder ah{"prog", "-m", "TEST1", "-f", "inputfile.graph",
+                          "-o",   "outputfile.graph", "-p", "-pj", "progress.json"};
+        cmdP.parse(ah.argc(), ah.argv());
+        REQUIRE(cmdP.isValid());
+        REQUIRE(cmdP.printProgress());
+        REQUIRE(cmdP.getProgressFile() == "progress.json");
+    }
+    SECTION("Parser test1 used, product cache") {
+        CommandLineParser cmdP(factoryMock.get());
+        ArgumentHolder ah{"prog", "-m", "TEST1", "-f", "inputfile.graph",  "-p", "-o",
+                          "outputfile.graph", "-cd", "cache", "-j", "4", "-s", "-idd",
+                          "-ml", "64"};
+        cmdP.parse(ah.argc(), ah.argv());
+        REQUIRE(cmdP.isValid());
+        REQUIRE(cmdP.getCacheDirectory() == "cache");
+        REQUIRE(cmdP.getMemoryLimit() == size_t(64) << 20);
+        REQUIRE(cmdP.getProductOptions() ==
+                std::vector<std::string>{"-m", "TEST1", "-s", "-idd"});
+    }
 }
 
 TEST_CASE("Run Tests", "Check we only run if it's appropriate") {
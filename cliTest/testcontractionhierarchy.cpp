@@ -0,0 +1,153 @@
+// SPDX-FileCopyrightText: 2026 depthmapX authors
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "depthmapXcli/contractionhierarchy.h"
+
+#include "salalib/genlib/exceptions.h"
+
+#include "catch_amalgamated.hpp"
+
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <random>
+#include <sstream>
+
+namespace {
+    // random directed graph where a third of the edges cost nothing, like
+    // the straight continuations of a topological segment graph
+    depthmapX::CsrGraph makeRandomGraph(unsigned int seed, size_t numNodes) {
+        std::mt19937 generator(seed);
+        std::uniform_int_distribution<size_t> pickNode(0, numNodes - 1);
+        std::uniform_int_distribution<int> pickWeight(0, 2);
+        depthmapX::CsrGraph graph;
+        for (size_t i = 0; i < numNodes; i++) {
+            std::vector<std::pair<size_t, float>> neighbours;
+            neighbours.push_back({(i + 1) % numNodes, static_cast<float>(pickWeight(generator))});
+            for (int j = 0; j < 2; j++) {
+                neighbours.push_back({pickNode(generator),
+                                      static_cast<float>(pickWeight(generator)) * 1.25f});
+            }
+            graph.addNode(neighbours);
+        }
+        return graph;
+    }
+
+    double pathLength(const depthmapX::CsrGraph &graph, const std::vector<size_t> &nodes) {
+        double length = 0;
+        for (size_t i = 1; i < nodes.size(); i++) {
+            double shortest = -1;
+            for (size_t e = graph.offsets[nodes[i - 1]]; e < graph.offsets[nodes[i - 1] + 1];
+                 e++) {
+                if (graph.targets[e] == nodes[i] &&
+                    (shortest < 0 || graph.weights[e] < shortest)) {
+                    shortest = static_cast<double>(graph.weights[e]);
+                }
+            }
+            REQUIRE(shortest >= 0);
+            length += shortest;
+        }
+        return length;
+    }
+} // namespace
+
+TEST_CASE("Contraction hierarchy agrees with bidirectional search") {
+    auto graph = makeRandomGraph(3, 400);
+    auto reverse = graph.reversed();
+    depthmapX::ShortestPathSearch search(graph, reverse);
+
+    auto hierarchy = depthmapX::ContractionHierarchy::build(graph);
+    REQUIRE(hierarchy.numNodes() == graph.numNodes());
+    depthmapX::ContractionHierarchyQuery query(hierarchy);
+
+    std::mt19937 generator(11);
+    std::uniform_int_distribution<size_t> pick(0, graph.numNodes() - 1);
+    for (int i = 0; i < 300; i++) {
+        std::vector<size_t> sources{pick(generator), pick(generator)};
+        std::vector<size_t> targets{pick(generator)};
+        auto expected = search.bidirectional(sources, targets, false);
+        auto result = query.query(sources, targets, true);
+        REQUIRE(result.found() == expected.found());
+        if (!expected.found()) {
+            continue;
+        }
+        REQUIRE(result.distance == Catch::Approx(expected.distance));
+        REQUIRE(std::find(sources.begin(), sources.end(), result.nodes.front()) !=
+                sources.end());
+        REQUIRE(result.nodes.back() == targets.front());
+        REQUIRE(pathLength(graph, result.nodes) == Catch::Approx(expected.distance));
+    }
+}
+
+TEST_CASE("Contraction hierarchy without a path") {
+    depthmapX::CsrGraph graph;
+    graph.addNode(std::vector<std::pair<size_t, float>>{{1, 1.0f}});
+    graph.addNode(std::vector<std::pair<size_t, float>>{});
+    auto hierarchy = depthmapX::ContractionHierarchy::build(graph);
+    depthmapX::ContractionHierarchyQuery query(hierarchy);
+
+    REQUIRE(query.query({0}, {1}, true).distance == Catch::Approx(1.0));
+    REQUIRE_FALSE(query.query({1}, {0}, true).found());
+    auto same = query.query({1}, {1}, true);
+    REQUIRE(same.distance == 0);
+    REQUIRE(same.nodes == std::vector<size_t>{1});
+}
+
+TEST_CASE("Contraction hierarchy write and read") {
+    auto graph = makeRandomGraph(5, 100);
+    auto hierarchy = depthmapX::ContractionHierarchy::build(graph);
+
+    std::stringstream stream;
+    hierarchy.write(stream);
+
+    SECTION("Same graph") {
+        depthmapX::ContractionHierarchy loaded;
+        REQUIRE(loaded.read(stream, graph));
+        REQUIRE(loaded.numNodes() == hierarchy.numNodes());
+        REQUIRE(loaded.numShortcuts() == hierarchy.numShortcuts());
+
+        depthmapX::ContractionHierarchyQuery original(hierarchy);
+        depthmapX::ContractionHierarchyQuery query(loaded);
+        for (size_t target = 0; target < graph.numNodes(); target++) {
+            REQUIRE(query.query({0}, {target}, false).distance ==
+                    original.query({0}, {target}, false).distance);
+        }
+    }
+
+    SECTION("Changed graph") {
+        graph.weights[0] += 1.0f;
+        depthmapX::ContractionHierarchy loaded;
+        REQUIRE_FALSE(loaded.read(stream, graph));
+        REQUIRE(loaded.numNodes() == 0);
+    }
+
+    SECTION("Truncated stream") {
+        std::stringstream truncated(stream.str().substr(0, stream.str().size() / 2));
+        depthmapX::ContractionHierarchy loaded;
+        REQUIRE_FALSE(loaded.read(truncated, graph));
+    }
+}
+
+TEST_CASE("Contraction hierarchy write to file") {
+    std::string directory = "contractionhierarchytest";
+    std::filesystem::remove_all(directory);
+    std::filesystem::create_directories(directory);
+    std::string hierarchyFile = directory + "/graph.graph.metric.ch";
+    auto graph = makeRandomGraph(5, 100);
+    auto hierarchy = depthmapX::ContractionHierarchy::build(graph);
+
+    // replacing a truncated file, leaving no temporary file behind
+    std::ofstream(hierarchyFile, std::ios::binary) << "truncated";
+    hierarchy.writeFile(hierarchyFile);
+    std::ifstream stream(hierarchyFile, std::ios::binary);
+    depthmapX::ContractionHierarchy loaded;
+    REQUIRE(loaded.read(stream, graph));
+    REQUIRE(loaded.numShortcuts() == hierarchy.numShortcuts());
+    REQUIRE(std::distance(std::filesystem::directory_iterator(directory),
+                          std::filesystem::directory_iterator()) == 1);
+
+    REQUIRE_THROWS_AS(hierarchy.writeFile(directory + "/nosuchdirectory/graph.ch"),
+                      depthmapX::RuntimeException);
+    std::filesystem::remove_all(directory);
+}
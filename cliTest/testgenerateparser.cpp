@@ -0,0 +1,69 @@
+// SPDX-FileCopyrightText: 2026 depthmapX authors
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "argumentholder.h"
+
+#include "depthmapXcli/generateparser.h"
+
+#include "catch_amalgamated.hpp"
+
+TEST_CASE("GenerateParser Fail", "Parsing errors") {
+    SECTION("Missing argument to -gt") {
+        GenerateParser parser;
+        ArgumentHolder ah{"prog", "-gt"};
+        REQUIRE_THROWS_WITH(parser.parse(ah.argc(), ah.argv()),
+                            Catch::Matchers::ContainsSubstring("-gt requires an argument"));
+    }
+
+    SECTION("Invalid map type") {
+        GenerateParser parser;
+        ArgumentHolder ah{"prog", "-gt", "village", "-gn", "100"};
+        REQUIRE_THROWS_WITH(parser.parse(ah.argc(), ah.argv()),
+                            Catch::Matchers::ContainsSubstring("Invalid map type (-gt): village"));
+    }
+
+    SECTION("Invalid size") {
+        GenerateParser parser;
+        ArgumentHolder ah{"prog", "-gt", "grid", "-gn", "0"};
+        REQUIRE_THROWS_WITH(parser.parse(ah.argc(), ah.argv()),
+                            Catch::Matchers::ContainsSubstring("-gn must be a positive number"));
+    }
+
+    SECTION("Missing map type") {
+        GenerateParser parser;
+        ArgumentHolder ah{"prog", "-gn", "100"};
+        REQUIRE_THROWS_WITH(parser.parse(ah.argc(), ah.argv()),
+                            Catch::Matchers::ContainsSubstring("-gt for the type of map"));
+    }
+
+    SECTION("Missing size") {
+        GenerateParser parser;
+        ArgumentHolder ah{"prog", "-gt", "plan"};
+        REQUIRE_THROWS_WITH(parser.parse(ah.argc(), ah.argv()),
+                            Catch::Matchers::ContainsSubstring("-gn for the size of the map"));
+    }
+}
+
+TEST_CASE("GenerateParser Success", "Read successfully") {
+    SECTION("Defaults") {
+        GenerateParser parser;
+        ArgumentHolder ah{"prog", "-gt", "plan", "-gn", "10000000"};
+        parser.parse(ah.argc(), ah.argv());
+        REQUIRE(parser.getMapType() == GenerateParser::MapType::FLOOR_PLAN);
+        REQUIRE(parser.getNumElements() == 10000000);
+        REQUIRE(parser.getElementSize() == Catch::Approx(4));
+        REQUIRE(parser.getSeed() == 1);
+        REQUIRE_FALSE(parser.needsInputFile());
+    }
+
+    SECTION("All options") {
+        GenerateParser parser;
+        ArgumentHolder ah{"prog", "-gt", "city", "-gn", "1000", "-gs", "75.5", "-grs", "42"};
+        parser.parse(ah.argc(), ah.argv());
+        REQUIRE(parser.getMapType() == GenerateParser::MapType::CITY);
+        REQUIRE(parser.getNumElements() == 1000);
+        REQUIRE(parser.getElementSize() == Catch::Approx(75.5));
+        REQUIRE(parser.getSeed() == 42);
+    }
+}
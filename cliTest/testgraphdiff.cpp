@@ -0,0 +1,90 @@
+// SPDX-FileCopyrightText: 2026 depthmapX authors
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "depthmapXcli/graphdiff.h"
+
+#include "catch_amalgamated.hpp"
+
+#include <cmath>
+
+namespace {
+    typedef std::vector<std::pair<size_t, float>> Edges;
+
+    // a chain 0 -> 1 -> 2 -> 3 of unit edges with a detour 0 -> 4 -> 3 of
+    // the given length per edge
+    depthmapX::CsrGraph makeChain(float detour) {
+        depthmapX::CsrGraph graph;
+        graph.addNode(Edges{{1, 1.0f}, {4, detour}});
+        graph.addNode(Edges{{2, 1.0f}});
+        graph.addNode(Edges{{3, 1.0f}});
+        graph.addNode(Edges{});
+        graph.addNode(Edges{{3, detour}});
+        return graph;
+    }
+} // namespace
+
+TEST_CASE("Changed nodes between graphs") {
+    auto base = makeChain(5.0f);
+    std::vector<int64_t> keys{10, 11, 12, 13, 14};
+
+    SECTION("Identical graphs") {
+        REQUIRE(depthmapX::changedNodes(base, keys, makeChain(5.0f), keys).empty());
+    }
+
+    SECTION("Changed weight") {
+        REQUIRE(depthmapX::changedNodes(base, keys, makeChain(1.0f), keys) ==
+                std::vector<size_t>{0, 4});
+    }
+
+    SECTION("Renumbered nodes are matched by key") {
+        depthmapX::CsrGraph edited;
+        edited.addNode(Edges{{3, 5.0f}});
+        edited.addNode(Edges{{4, 1.0f}, {0, 5.0f}});
+        edited.addNode(Edges{{3, 1.0f}});
+        edited.addNode(Edges{});
+        edited.addNode(Edges{{2, 1.0f}});
+        std::vector<int64_t> editedKeys{14, 10, 12, 13, 11};
+        REQUIRE(depthmapX::changedNodes(base, keys, edited, editedKeys).empty());
+    }
+
+    SECTION("Added and removed nodes") {
+        depthmapX::CsrGraph edited;
+        edited.addNode(Edges{{1, 1.0f}});
+        edited.addNode(Edges{{2, 1.0f}});
+        edited.addNode(Edges{{3, 1.0f}});
+        edited.addNode(Edges{});
+        edited.addNode(Edges{{3, 1.0f}});
+        std::vector<int64_t> editedKeys{10, 11, 12, 13, 15};
+        REQUIRE(depthmapX::changedNodes(base, keys, edited, editedKeys) ==
+                std::vector<size_t>{0, 4});
+    }
+}
+
+TEST_CASE("Bounds on paths through changed nodes") {
+    auto graph = makeChain(1.0f);
+    auto reverse = graph.reversed();
+    std::vector<std::vector<size_t>> sources{{0}, {1}};
+    std::vector<std::vector<size_t>> targets{{3}, {2}};
+
+    SECTION("No changes") {
+        depthmapX::ChangedPathBounds bounds(graph, reverse, {}, sources, targets);
+        REQUIRE(std::isinf(bounds.bound(0, 0)));
+    }
+
+    SECTION("Changed detour") {
+        depthmapX::ChangedPathBounds bounds(graph, reverse, {4}, sources, targets);
+        // 0 -> 4 -> 3
+        REQUIRE(bounds.bound(0, 0) == Catch::Approx(2.0));
+        // node 4 can not be reached from 1 nor reach 2
+        REQUIRE(std::isinf(bounds.bound(1, 0)));
+        REQUIRE(std::isinf(bounds.bound(0, 1)));
+    }
+
+    SECTION("Closest of several changed nodes") {
+        depthmapX::ChangedPathBounds bounds(graph, reverse, {4, 2}, sources, targets);
+        REQUIRE(bounds.bound(0, 0) == Catch::Approx(2.0));
+        REQUIRE(bounds.bound(1, 0) == Catch::Approx(2.0));
+        REQUIRE(bounds.bound(0, 1) == Catch::Approx(2.0));
+    }
+}
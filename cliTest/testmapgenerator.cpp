@@ -0,0 +1,61 @@
+// SPDX-FileCopyrightText: 2026 depthmapX authors
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "depthmapXcli/mapgenerator.h"
+
+#include "catch_amalgamated.hpp"
+
+#include <algorithm>
+
+TEST_CASE("Generated street grid") {
+    // 2 blocks a side
+    auto lines = depthmapX::generateStreetGrid(12, 10);
+    REQUIRE(lines.size() == 12);
+    double maxX = 0;
+    double totalLength = 0;
+    for (const auto &line : lines) {
+        maxX = std::max(maxX, std::max(line.ax(), line.bx()));
+        totalLength += line.length();
+    }
+    REQUIRE(maxX == Catch::Approx(20));
+    REQUIRE(totalLength == Catch::Approx(120));
+
+    // the size is rounded to the nearest whole grid
+    REQUIRE(depthmapX::generateStreetGrid(1, 10).size() == 4);
+    REQUIRE(depthmapX::generateStreetGrid(1000, 10).size() == 2 * 22 * 23);
+}
+
+TEST_CASE("Generated city fabric") {
+    auto lines = depthmapX::generateCityFabric(10000, 50, 7);
+    REQUIRE(lines.size() > 9000);
+    REQUIRE(lines.size() < 11000);
+    for (const auto &line : lines) {
+        // junctions move by no more than a third of a block
+        REQUIRE(line.length() > 50.0 / 3);
+        REQUIRE(line.length() < 50 * 2);
+    }
+
+    // the same for the same seed only
+    auto again = depthmapX::generateCityFabric(10000, 50, 7);
+    REQUIRE(again.size() == lines.size());
+    REQUIRE(again[100].ax() == lines[100].ax());
+    REQUIRE(again[100].by() == lines[100].by());
+    auto other = depthmapX::generateCityFabric(10000, 50, 8);
+    REQUIRE((other.size() != lines.size() || other[100].ax() != lines[100].ax()));
+}
+
+TEST_CASE("Generated floor plan") {
+    // 3 x 3 rooms: the outline and 2 * 3 inner walls on either axis, each in
+    // two halves around the door
+    auto lines = depthmapX::generateFloorPlan(9, 4);
+    REQUIRE(lines.size() == 4 + 4 * 3 * 2);
+    double wallLength = 0;
+    for (const auto &line : lines) {
+        wallLength += line.length();
+    }
+    // the outline plus the inner walls less one door of a quarter room each
+    REQUIRE(wallLength == Catch::Approx(4 * 12 + 12 * 3));
+
+    REQUIRE(depthmapX::generateFloorPlan(1, 4).size() == 4);
+}
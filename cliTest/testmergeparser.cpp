@@ -0,0 +1,123 @@
+// SPDX-FileCopyrightText: 2026 depthmapX authors
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "argumentholder.h"
+
+#include "selfcleaningfile.h"
+
+#include "depthmapXcli/commandlineparser.h"
+#include "depthmapXcli/mergeparser.h"
+#include "depthmapXcli/modeparserregistry.h"
+#include "depthmapXcli/performancewriter.h"
+#include "depthmapXcli/runmethods.h"
+
+#include "catch_amalgamated.hpp"
+
+#include <fstream>
+#include <iterator>
+
+namespace {
+    void runCli(const ArgumentHolder &ah) {
+        ModeParserRegistry registry;
+        CommandLineParser clp(registry);
+        clp.parse(ah.argc(), ah.argv());
+        PerformanceWriter perfWriter("");
+        clp.run(perfWriter);
+    }
+
+    void writeFile(const std::string &filename, const std::string &content) {
+        std::ofstream stream(filename);
+        stream << content;
+    }
+
+    std::string readFile(const std::string &filename) {
+        std::ifstream stream(filename);
+        return std::string(std::istreambuf_iterator<char>(stream),
+                           std::istreambuf_iterator<char>());
+    }
+} // namespace
+
+TEST_CASE("MergeParser Fail", "Parsing errors") {
+    SECTION("Missing argument to -mgf") {
+        MergeParser parser;
+        ArgumentHolder ah{"prog", "-mgf"};
+        REQUIRE_THROWS_WITH(parser.parse(ah.argc(), ah.argv()),
+                            Catch::Matchers::ContainsSubstring("-mgf requires an argument"));
+    }
+
+    SECTION("No shard to merge") {
+        MergeParser parser;
+        ArgumentHolder ah{"prog", "-f", "shard1.graph"};
+        REQUIRE_THROWS_WITH(parser.parse(ah.argc(), ah.argv()),
+                            Catch::Matchers::ContainsSubstring(
+                                "At least one -mgf shard must be given"));
+    }
+}
+
+TEST_CASE("MergeParser Success", "Read successfully") {
+    MergeParser parser;
+    ArgumentHolder ah{"prog",         "-f",   "shard1.graph", "-mgf",
+                      "shard2.graph", "-mgf", "shard3.graph"};
+    parser.parse(ah.argc(), ah.argv());
+    REQUIRE(parser.getShardFiles() == std::vector<std::string>{"shard2.graph", "shard3.graph"});
+}
+
+TEST_CASE("MergeParser merges step depth shards") {
+    const std::string graphFile = std::string(CLITEST_TESTDATA) + "/gallery_connected.graph";
+    SelfCleaningFile points("mergepoints.tsv");
+    SelfCleaningFile full("mergefull.graph");
+    SelfCleaningFile shard1("mergeshard1.graph");
+    SelfCleaningFile shard2("mergeshard2.graph");
+    SelfCleaningFile merged("mergemerged.graph");
+    writeFile(points.Filename(), "x\ty\n0.68\t7.04\n2.92\t5.16\n0.68\t7.08\n");
+
+    runCli({"prog", "-m", "STEPDEPTH", "-f", graphFile, "-o", full.Filename(), "-sdt", "visual",
+            "-sdf", points.Filename(), "-sdm"});
+    runCli({"prog", "-m", "STEPDEPTH", "-f", graphFile, "-o", shard1.Filename(), "-sdt", "visual",
+            "-sdf", points.Filename(), "-sdm", "-or", "0:2"});
+    runCli({"prog", "-m", "STEPDEPTH", "-f", graphFile, "-o", shard2.Filename(), "-sdt", "visual",
+            "-sdf", points.Filename(), "-sdm", "-or", "2:3"});
+    runCli({"prog", "-m", "MERGE", "-f", shard1.Filename(), "-mgf", shard2.Filename(), "-o",
+            merged.Filename()});
+
+    PerformanceWriter perfWriter("");
+    auto fullGraph = dm_runmethods::loadGraph(full.Filename(), perfWriter);
+    auto mergedGraph = dm_runmethods::loadGraph(merged.Filename(), perfWriter);
+    const auto &fullTable = fullGraph.getDisplayedMapAttributes();
+    const auto &mergedTable = mergedGraph.getDisplayedMapAttributes();
+    REQUIRE(mergedTable.getNumRows() == fullTable.getNumRows());
+    size_t numDepthColumns = 0;
+    for (size_t col = 0; col < fullTable.getNumColumns(); col++) {
+        const std::string &name = fullTable.getColumnName(col);
+        if (name.rfind("Visual Step Depth ", 0) != 0) {
+            continue;
+        }
+        numDepthColumns++;
+        REQUIRE(mergedTable.hasColumn(name));
+        size_t mergedCol = mergedTable.getColumnIndex(name);
+        for (auto iter = fullTable.begin(); iter != fullTable.end(); ++iter) {
+            REQUIRE(mergedTable.getRow(iter->getKey()).getValue(mergedCol) ==
+                    iter->getRow().getValue(col));
+        }
+    }
+    REQUIRE(numDepthColumns == 3);
+}
+
+TEST_CASE("MergeParser appends od csv shards") {
+    SelfCleaningFile shard1("mergeshard1.csv");
+    SelfCleaningFile shard2("mergeshard2.csv");
+    SelfCleaningFile merged("mergemerged.csv");
+    writeFile(shard1.Filename(), "Origin Ref,Destination Ref,Metric Distance\n1,2,3.5\n");
+    writeFile(shard2.Filename(), "Origin Ref,Destination Ref,Metric Distance\n2,3,1\n4,1,2\n");
+
+    runCli({"prog", "-m", "MERGE", "-f", shard1.Filename(), "-mgf", shard2.Filename(), "-o",
+            merged.Filename()});
+    REQUIRE(readFile(merged.Filename()) ==
+            "Origin Ref,Destination Ref,Metric Distance\n1,2,3.5\n2,3,1\n4,1,2\n");
+
+    writeFile(shard2.Filename(), "Origin Ref,Destination Ref,Tulip Distance\n2,3,1\n");
+    REQUIRE_THROWS_WITH(runCli({"prog", "-m", "MERGE", "-f", shard1.Filename(), "-mgf",
+                                shard2.Filename(), "-o", merged.Filename()}),
+                        Catch::Matchers::ContainsSubstring("are not the same as those of"));
+}
@@ -0,0 +1,176 @@
+// SPDX-FileCopyrightText: 2026 depthmapX authors
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "depthmapXcli/multisourcebfs.h"
+
+#include "catch_amalgamated.hpp"
+
+#include <deque>
+#include <queue>
+#include <random>
+
+namespace {
+    // undirected path 0 - 1 - 2 - 3 - 4 plus an isolated node 5
+    depthmapX::CsrGraph makePath() {
+        depthmapX::CsrGraph graph;
+        graph.addNode(std::vector<size_t>{1});
+        graph.addNode(std::vector<size_t>{0, 2});
+        graph.addNode(std::vector<size_t>{1, 3});
+        graph.addNode(std::vector<size_t>{2, 4});
+        graph.addNode(std::vector<size_t>{3});
+        graph.addNode(std::vector<size_t>{});
+        return graph;
+    }
+
+    std::vector<int> plainBfs(const depthmapX::CsrGraph &graph, size_t origin) {
+        std::vector<int> depths(graph.numNodes(), -1);
+        std::queue<size_t> queue;
+        depths[origin] = 0;
+        queue.push(origin);
+        while (!queue.empty()) {
+            size_t node = queue.front();
+            queue.pop();
+            for (size_t e = graph.offsets[node]; e < graph.offsets[node + 1]; e++) {
+                if (depths[graph.targets[e]] == -1) {
+                    depths[graph.targets[e]] = depths[node] + 1;
+                    queue.push(graph.targets[e]);
+                }
+            }
+        }
+        return depths;
+    }
+
+    // breadth first with edges of weight 0 taken before the others
+    std::vector<int> zeroOneBfs(const depthmapX::CsrGraph &graph, size_t origin) {
+        std::vector<int> depths(graph.numNodes(), -1);
+        std::vector<char> done(graph.numNodes(), 0);
+        std::deque<size_t> queue;
+        depths[origin] = 0;
+        queue.push_back(origin);
+        while (!queue.empty()) {
+            size_t node = queue.front();
+            queue.pop_front();
+            if (done[node]) {
+                continue;
+            }
+            done[node] = 1;
+            for (size_t e = graph.offsets[node]; e < graph.offsets[node + 1]; e++) {
+                size_t next = graph.targets[e];
+                int step = graph.weights[e] == 0.0f ? 0 : 1;
+                if (depths[next] == -1 || depths[node] + step < depths[next]) {
+                    depths[next] = depths[node] + step;
+                    if (step == 0) {
+                        queue.push_front(next);
+                    } else {
+                        queue.push_back(next);
+                    }
+                }
+            }
+        }
+        return depths;
+    }
+} // namespace
+
+TEST_CASE("Multi-source step depth on a path") {
+    auto graph = makePath();
+
+    SECTION("Single origins") {
+        auto depths = depthmapX::multiSourceStepDepth(graph, {{0}, {2}, {5}});
+        REQUIRE(depths.size() == 3);
+        REQUIRE(depths[0] == std::vector<int>{0, 1, 2, 3, 4, -1});
+        REQUIRE(depths[1] == std::vector<int>{2, 1, 0, 1, 2, -1});
+        REQUIRE(depths[2] == std::vector<int>{-1, -1, -1, -1, -1, 0});
+    }
+
+    SECTION("Origin group takes the nearest member") {
+        auto depths = depthmapX::multiSourceStepDepth(graph, {{0, 4}});
+        REQUIRE(depths.size() == 1);
+        REQUIRE(depths[0] == std::vector<int>{0, 1, 2, 1, 0, -1});
+    }
+
+    SECTION("Origin outside of the graph") {
+        REQUIRE_THROWS_AS(depthmapX::multiSourceStepDepth(graph, {{6}}), std::out_of_range);
+    }
+
+    SECTION("Cancelled before the batches start") {
+        depthmapX::CancellationToken token;
+        token.cancel();
+        auto depths = depthmapX::multiSourceStepDepth(graph, {{0}, {2}}, token);
+        REQUIRE(depths.size() == 2);
+        REQUIRE(depths[0].empty());
+        REQUIRE(depths[1].empty());
+    }
+}
+
+TEST_CASE("Multi-source step depth matches single searches across batches") {
+    // a ring of 150 nodes with chords, so that more than two batches are needed
+    const size_t numNodes = 150;
+    depthmapX::CsrGraph graph;
+    for (size_t i = 0; i < numNodes; i++) {
+        std::vector<size_t> neighbours{(i + 1) % numNodes, (i + numNodes - 1) % numNodes};
+        if (i % 7 == 0) {
+            neighbours.push_back((i * 3) % numNodes);
+        }
+        graph.addNode(neighbours);
+    }
+
+    std::vector<std::vector<size_t>> origins;
+    for (size_t i = 0; i < numNodes; i++) {
+        origins.push_back({i});
+    }
+    auto depths = depthmapX::multiSourceStepDepth(graph, origins);
+    REQUIRE(depths.size() == numNodes);
+    for (size_t i = 0; i < numNodes; i++) {
+        REQUIRE(depths[i] == plainBfs(graph, i));
+    }
+}
+
+TEST_CASE("Multi-source step depth through merged pixels") {
+    // two rooms 0 - 1 - 2 and 3 - 4 - 5, where 1 and 2 see each other and 3
+    // sees 4 and 5, with 2 merged with 3. As in salalib's visual step depth
+    // a merged pixel is at the depth of the pixel it is merged with
+    typedef std::vector<std::pair<size_t, float>> Edges;
+    depthmapX::CsrGraph graph;
+    graph.addNode(Edges{{1, 1.0f}});
+    graph.addNode(Edges{{0, 1.0f}, {2, 1.0f}});
+    graph.addNode(Edges{{1, 1.0f}, {3, 0.0f}});
+    graph.addNode(Edges{{2, 0.0f}, {4, 1.0f}, {5, 1.0f}});
+    graph.addNode(Edges{{3, 1.0f}, {5, 1.0f}});
+    graph.addNode(Edges{{3, 1.0f}, {4, 1.0f}});
+
+    auto depths = depthmapX::multiSourceStepDepth(graph, {{0}, {3}, {5}});
+    REQUIRE(depths[0] == std::vector<int>{0, 1, 2, 2, 3, 3});
+    REQUIRE(depths[1] == std::vector<int>{2, 1, 0, 0, 1, 1});
+    REQUIRE(depths[2] == std::vector<int>{3, 2, 1, 1, 1, 0});
+}
+
+TEST_CASE("Multi-source step depth with merged pixels matches single searches") {
+    // a visibility graph of random pairs with a matching of merge links
+    const size_t numNodes = 200;
+    std::mt19937 generator(7);
+    std::vector<std::vector<std::pair<size_t, float>>> edges(numNodes);
+    for (size_t e = 0; e < 300; e++) {
+        size_t a = generator() % numNodes;
+        size_t b = generator() % numNodes;
+        edges[a].push_back({b, 1.0f});
+        edges[b].push_back({a, 1.0f});
+    }
+    for (size_t a = 0; a + 1 < numNodes; a += 10) {
+        edges[a].push_back({a + 1, 0.0f});
+        edges[a + 1].push_back({a, 0.0f});
+    }
+    depthmapX::CsrGraph graph;
+    for (const auto &nodeEdges : edges) {
+        graph.addNode(nodeEdges);
+    }
+
+    std::vector<std::vector<size_t>> origins;
+    for (size_t i = 0; i < numNodes; i++) {
+        origins.push_back({i});
+    }
+    auto depths = depthmapX::multiSourceStepDepth(graph, origins);
+    for (size_t i = 0; i < numNodes; i++) {
+        REQUIRE(depths[i] == zeroOneBfs(graph, i));
+    }
+}
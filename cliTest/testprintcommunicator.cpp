@@ -0,0 +1,104 @@
+// SPDX-FileCopyrightText: 2026 depthmapX authors
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "depthmapXcli/printcommunicator.h"
+
+#include "selfcleaningfile.h"
+
+#include "catch_amalgamated.hpp"
+
+#include <fstream>
+#include <sstream>
+
+TEST_CASE("PrintCommunicator formats durations") {
+    REQUIRE(PrintCommunicator::formatDuration(-3) == "0s");
+    REQUIRE(PrintCommunicator::formatDuration(44.6) == "45s");
+    REQUIRE(PrintCommunicator::formatDuration(185) == "3m05s");
+    REQUIRE(PrintCommunicator::formatDuration(7830) == "2h10m");
+}
+
+TEST_CASE("PrintCommunicator reports progress") {
+    std::stringstream stream;
+
+    SECTION("Final state is printed once") {
+        {
+            // long enough for the reporter not to get a go
+            PrintCommunicator comm(&stream, std::string(), std::chrono::hours(1));
+            comm.CommPostMessage(Communicator::NUM_STEPS, 2);
+            comm.CommPostMessage(Communicator::CURRENT_STEP, 1);
+            comm.CommPostMessage(Communicator::NUM_RECORDS, 200);
+            for (size_t i = 1; i <= 50; i++) {
+                comm.CommPostMessage(Communicator::CURRENT_RECORD, i);
+            }
+        }
+        std::string line;
+        std::getline(stream, line);
+        REQUIRE(line.rfind("step: 1/2 record: 50/200 (25.0%), ", 0) == 0);
+        REQUIRE(line.find(" records/s") != std::string::npos);
+        REQUIRE(line.find("ETA") == std::string::npos);
+        REQUIRE_FALSE(std::getline(stream, line));
+    }
+
+    SECTION("Record is capped at the number of records") {
+        {
+            PrintCommunicator comm(&stream, std::string(), std::chrono::hours(1));
+            comm.CommPostMessage(Communicator::NUM_RECORDS, 10);
+            comm.CommPostMessage(Communicator::CURRENT_RECORD, 12);
+        }
+        REQUIRE(stream.str().rfind("step: 0/0 record: 10/10 (100.0%)", 0) == 0);
+    }
+
+    SECTION("Periodic reports") {
+        {
+            PrintCommunicator comm(&stream, std::string(), std::chrono::milliseconds(1));
+            comm.CommPostMessage(Communicator::NUM_RECORDS, 1000);
+            for (size_t i = 1; i <= 1000; i++) {
+                comm.CommPostMessage(Communicator::CURRENT_RECORD, i);
+                if (i % 100 == 0) {
+                    std::this_thread::sleep_for(std::chrono::milliseconds(5));
+                }
+            }
+        }
+        std::string line, last;
+        size_t lines = 0;
+        while (std::getline(stream, line)) {
+            lines++;
+            last = line;
+        }
+        REQUIRE(lines > 1);
+        REQUIRE(last.rfind("step: 0/0 record: 1000/1000 (100.0%)", 0) == 0);
+    }
+}
+
+TEST_CASE("PrintCommunicator progress file") {
+    SelfCleaningFile progressFile("progress.json");
+    {
+        PrintCommunicator comm(nullptr, progressFile.Filename(), std::chrono::hours(1));
+        comm.CommPostMessage(Communicator::NUM_STEPS, 3);
+        comm.CommPostMessage(Communicator::CURRENT_STEP, 2);
+        comm.CommPostMessage(Communicator::NUM_RECORDS, 40);
+        comm.CommPostMessage(Communicator::CURRENT_RECORD, 40);
+    }
+    std::ifstream file(progressFile.Filename());
+    std::string content;
+    std::getline(file, content);
+    REQUIRE(content.rfind("{\"running\": false, \"step\": 2, \"numSteps\": 3, \"record\": 40, "
+                          "\"numRecords\": 40, \"elapsedSeconds\": ",
+                          0) == 0);
+    REQUIRE(content.find("\"etaSeconds\": null}") != std::string::npos);
+    std::ifstream tempFile(progressFile.Filename() + ".tmp");
+    REQUIRE_FALSE(tempFile.good());
+}
+
+TEST_CASE("PrintCommunicator cancels with its token") {
+    depthmapX::CancellationToken token;
+    std::stringstream stream;
+    PrintCommunicator comm(&stream, std::string(), std::chrono::milliseconds(1), &token);
+    REQUIRE_FALSE(comm.IsCancelled());
+    token.cancel();
+    for (int i = 0; i < 1000 && !comm.IsCancelled(); i++) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    }
+    REQUIRE(comm.IsCancelled());
+}
@@ -0,0 +1,132 @@
+// SPDX-FileCopyrightText: 2026 depthmapX authors
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "argumentholder.h"
+
+#include "depthmapXcli/cancellationtoken.h"
+#include "depthmapXcli/commandlineparser.h"
+#include "depthmapXcli/modeparserregistry.h"
+#include "depthmapXcli/performancewriter.h"
+#include "depthmapXcli/productcache.h"
+#include "depthmapXcli/runmethods.h"
+
+#include "salalib/genlib/exceptions.h"
+
+#include "selfcleaningfile.h"
+
+#include "catch_amalgamated.hpp"
+
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+
+namespace {
+    void writeFile(const std::string &filename, const std::string &content) {
+        std::ofstream stream(filename, std::ios::binary);
+        stream << content;
+    }
+
+    std::string readFile(const std::string &filename) {
+        std::ifstream stream(filename, std::ios::binary);
+        return std::string(std::istreambuf_iterator<char>(stream),
+                           std::istreambuf_iterator<char>());
+    }
+} // namespace
+
+TEST_CASE("Product cache keys") {
+    SelfCleaningFile input("productinput.graph");
+    writeFile(input.Filename(), "graph contents");
+    std::string key =
+        depthmapX::ProductCache::key(input.Filename(), {"-m", "VISPREP", "-pg", "0.5"});
+    REQUIRE(key == depthmapX::ProductCache::key(input.Filename(),
+                                                {"-m", "VISPREP", "-pg", "0.5"}));
+    REQUIRE(key != depthmapX::ProductCache::key(input.Filename(),
+                                                {"-m", "VISPREP", "-pg", "0.25"}));
+    REQUIRE(key != depthmapX::ProductCache::key(input.Filename(),
+                                                {"-m", "VISPREP", "-pg0.5"}));
+
+    writeFile(input.Filename(), "other graph contents");
+    REQUIRE(key != depthmapX::ProductCache::key(input.Filename(),
+                                                {"-m", "VISPREP", "-pg", "0.5"}));
+
+    REQUIRE_THROWS_AS(depthmapX::ProductCache::key("nosuchinput.graph", {}),
+                      depthmapX::RuntimeException);
+}
+
+TEST_CASE("Product cache keys of runs naming data files") {
+    SelfCleaningFile input("productinput.graph");
+    SelfCleaningFile points("productpoints.tsv");
+    writeFile(input.Filename(), "graph contents");
+    writeFile(points.Filename(), "x\ty\n1\t1\n");
+    std::vector<std::string> options{"-m", "VISPREP", "-pf", points.Filename()};
+    std::string key = depthmapX::ProductCache::key(input.Filename(), options, {points.Filename()});
+    REQUIRE(key == depthmapX::ProductCache::key(input.Filename(), options, {points.Filename()}));
+    REQUIRE(key != depthmapX::ProductCache::key(input.Filename(), options));
+
+    // the same -pf file with other points is a miss
+    writeFile(points.Filename(), "x\ty\n2\t2\n");
+    REQUIRE(key != depthmapX::ProductCache::key(input.Filename(), options, {points.Filename()}));
+
+    REQUIRE_THROWS_AS(
+        depthmapX::ProductCache::key(input.Filename(), options, {"nosuchpoints.tsv"}),
+        depthmapX::RuntimeException);
+}
+
+TEST_CASE("Product cache fetch and store") {
+    std::string directory = "productcachetest";
+    std::filesystem::remove_all(directory);
+    SelfCleaningFile output("productoutput.graph");
+    SelfCleaningFile copy("productcopy.graph");
+    depthmapX::ProductCache cache(directory);
+
+    REQUIRE_FALSE(cache.fetch("1234abcd", copy.Filename()));
+    REQUIRE_FALSE(std::ifstream(copy.Filename()).good());
+
+    writeFile(output.Filename(), "visibility graph");
+    cache.store("1234abcd", output.Filename());
+    REQUIRE(cache.fetch("1234abcd", copy.Filename()));
+    REQUIRE(readFile(copy.Filename()) == "visibility graph");
+
+    // storing again replaces the product, leaving no temporary files
+    writeFile(output.Filename(), "new visibility graph");
+    cache.store("1234abcd", output.Filename());
+    REQUIRE(cache.fetch("1234abcd", copy.Filename()));
+    REQUIRE(readFile(copy.Filename()) == "new visibility graph");
+    REQUIRE(std::distance(std::filesystem::directory_iterator(directory),
+                          std::filesystem::directory_iterator()) == 1);
+
+    REQUIRE_THROWS_AS(cache.store("5678", "nosuchoutput.graph"), depthmapX::RuntimeException);
+    std::filesystem::remove_all(directory);
+}
+
+TEST_CASE("Product cache stores of cancelled runs") {
+    std::string directory = "productcachetest";
+    std::filesystem::remove_all(directory);
+    SelfCleaningFile input("productinput.graph");
+    SelfCleaningFile output("productoutput.graph");
+    SelfCleaningFile copy("productcopy.graph");
+    writeFile(input.Filename(), "graph contents");
+    writeFile(output.Filename(), "visibility graph");
+
+    ModeParserRegistry registry;
+    CommandLineParser clp(registry);
+    ArgumentHolder ah{"prog", "-m",  "VISPREP", "-f",  input.Filename(), "-o", output.Filename(),
+                      "-cd",  directory, "-pg", "0.5",  "-tb", "10"};
+    clp.parse(ah.argc(), ah.argv());
+    PerformanceWriter perfWriter("");
+    std::string key;
+    REQUIRE_FALSE(dm_runmethods::fetchCachedProduct(clp, perfWriter, key));
+    REQUIRE_FALSE(key.empty());
+
+    // a run the time budget cut short leaves no entry
+    depthmapX::CancellationToken token;
+    token.setDeadline(depthmapX::CancellationToken::Clock::now() - std::chrono::seconds(1));
+    dm_runmethods::storeCachedProduct(clp, key, perfWriter, token);
+    REQUIRE_FALSE(depthmapX::ProductCache(directory).fetch(key, copy.Filename()));
+
+    dm_runmethods::storeCachedProduct(clp, key, perfWriter, depthmapX::CancellationToken());
+    REQUIRE(depthmapX::ProductCache(directory).fetch(key, copy.Filename()));
+    REQUIRE(readFile(copy.Filename()) == "visibility graph");
+    std::filesystem::remove_all(directory);
+}
@@ -0,0 +1,165 @@
+// SPDX-FileCopyrightText: 2026 depthmapX authors
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "depthmapXcli/csrgraph.h"
+#include "depthmapXcli/radixheap.h"
+
+#include "catch_amalgamated.hpp"
+
+#include <limits>
+#include <queue>
+#include <random>
+
+namespace {
+    // 4-connected lattice with random edge weights, a stand-in for the
+    // segment and visibility graphs the searches run on
+    depthmapX::CsrGraph makeLattice(size_t side, unsigned int seed) {
+        std::mt19937 generator(seed);
+        std::uniform_real_distribution<float> weight(0.5f, 2.0f);
+        depthmapX::CsrGraph graph;
+        for (size_t i = 0; i < side * side; i++) {
+            std::vector<std::pair<size_t, float>> neighbours;
+            if (i % side != 0) {
+                neighbours.push_back({i - 1, weight(generator)});
+            }
+            if (i % side != side - 1) {
+                neighbours.push_back({i + 1, weight(generator)});
+            }
+            if (i >= side) {
+                neighbours.push_back({i - side, weight(generator)});
+            }
+            if (i + side < side * side) {
+                neighbours.push_back({i + side, weight(generator)});
+            }
+            graph.addNode(neighbours);
+        }
+        return graph;
+    }
+
+    // Dijkstra over the whole graph, the queue only needing push(distance,
+    // node) and pop() returning the closest entry
+    template <typename Queue>
+    double sumOfDistances(const depthmapX::CsrGraph &graph, Queue &queue) {
+        std::vector<double> dist(graph.numNodes(), -1);
+        queue.push(0, 0);
+        double sum = 0;
+        while (!queue.empty()) {
+            auto [distance, node] = queue.pop();
+            if (dist[node] >= 0) {
+                continue;
+            }
+            dist[node] = distance;
+            sum += distance;
+            for (size_t e = graph.offsets[node]; e < graph.offsets[node + 1]; e++) {
+                if (dist[graph.targets[e]] < 0) {
+                    queue.push(distance + static_cast<double>(graph.weights[e]), graph.targets[e]);
+                }
+            }
+        }
+        return sum;
+    }
+
+    // the binary heap the searches used before, with the same interface
+    struct BinaryHeap {
+        typedef std::pair<double, size_t> Entry;
+        std::priority_queue<Entry, std::vector<Entry>, std::greater<Entry>> queue;
+
+        void push(double distance, size_t node) { queue.push({distance, node}); }
+        Entry pop() {
+            Entry entry = queue.top();
+            queue.pop();
+            return entry;
+        }
+        bool empty() const { return queue.empty(); }
+    };
+} // namespace
+
+TEST_CASE("RadixHeap pops in order") {
+    depthmapX::RadixHeap heap;
+    REQUIRE(heap.empty());
+
+    std::mt19937 generator(1);
+    std::uniform_real_distribution<double> step(0.0, 10.0);
+    std::priority_queue<double, std::vector<double>, std::greater<double>> expected;
+    double last = 0;
+    for (int round = 0; round < 200; round++) {
+        // Dijkstra-like: every push is at or above the last distance popped
+        for (int i = 0; i < 5; i++) {
+            double distance = last + (i == 0 ? 0.0 : step(generator));
+            heap.push(distance, static_cast<size_t>(round));
+            expected.push(distance);
+        }
+        for (int i = 0; i < 3; i++) {
+            REQUIRE(heap.top().first == expected.top());
+            auto entry = heap.pop();
+            REQUIRE(entry.first == expected.top());
+            last = entry.first;
+            expected.pop();
+        }
+    }
+    REQUIRE(heap.size() == expected.size());
+    while (!heap.empty()) {
+        REQUIRE(heap.pop().first == expected.top());
+        expected.pop();
+    }
+}
+
+TEST_CASE("RadixHeap edge cases") {
+    depthmapX::RadixHeap heap;
+
+    SECTION("Zero and infinite distances") {
+        heap.push(std::numeric_limits<double>::infinity(), 1);
+        heap.push(-0.0, 2);
+        heap.push(0, 3);
+        REQUIRE(heap.pop().first == 0);
+        REQUIRE(heap.pop().first == 0);
+        auto entry = heap.pop();
+        REQUIRE(entry.first == std::numeric_limits<double>::infinity());
+        REQUIRE(entry.second == 1);
+    }
+
+    SECTION("Distance below the last one popped") {
+        heap.push(2.0, 1);
+        REQUIRE(heap.pop().first == 2.0);
+        heap.push(1.9999999, 2);
+        auto entry = heap.pop();
+        REQUIRE(entry.first == 2.0);
+        REQUIRE(entry.second == 2);
+    }
+
+    SECTION("Clear") {
+        heap.push(5.0, 1);
+        REQUIRE(heap.pop().first == 5.0);
+        heap.push(6.0, 2);
+        heap.clear();
+        REQUIRE(heap.empty());
+        heap.push(1.0, 3);
+        REQUIRE(heap.pop() == depthmapX::RadixHeap::Entry(1.0, 3));
+    }
+}
+
+TEST_CASE("RadixHeap Dijkstra matches binary heap") {
+    auto graph = makeLattice(30, 2);
+    depthmapX::RadixHeap radixHeap;
+    BinaryHeap binaryHeap;
+    REQUIRE(sumOfDistances(graph, radixHeap) == Catch::Approx(sumOfDistances(graph, binaryHeap)));
+}
+
+// not run by default, select with the [benchmark] tag. Divide by the number
+// of edges of the lattice for the cost per relaxation
+TEST_CASE("RadixHeap Dijkstra benchmark", "[.][benchmark]") {
+    auto graph = makeLattice(300, 3);
+    INFO("Edges: " << graph.numEdges());
+
+    BENCHMARK("Binary heap") {
+        BinaryHeap heap;
+        return sumOfDistances(graph, heap);
+    };
+
+    depthmapX::RadixHeap radixHeap;
+    BENCHMARK("Radix heap") {
+        radixHeap.clear();
+        return sumOfDistances(graph, radixHeap);
+    };
+}
@@ -0,0 +1,37 @@
+// SPDX-FileCopyrightText: 2026 depthmapX authors
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "depthmapXcli/regionofinterest.h"
+
+#include "salalib/genlib/exceptions.h"
+
+#include "catch_amalgamated.hpp"
+
+TEST_CASE("Region of interest contains") {
+    SECTION("Square") {
+        depthmapX::RegionOfInterest roi(
+            {Point2f(0, 0), Point2f(10, 0), Point2f(10, 10), Point2f(0, 10)});
+        REQUIRE(roi.contains(Point2f(5, 5)));
+        REQUIRE(roi.contains(Point2f(0.1, 9.9)));
+        REQUIRE_FALSE(roi.contains(Point2f(-1, 5)));
+        REQUIRE_FALSE(roi.contains(Point2f(5, 10.5)));
+        REQUIRE_FALSE(roi.contains(Point2f(11, 11)));
+    }
+
+    SECTION("Concave") {
+        // a U shape open to the top
+        depthmapX::RegionOfInterest roi({Point2f(0, 0), Point2f(9, 0), Point2f(9, 9), Point2f(6, 9),
+                                         Point2f(6, 3), Point2f(3, 3), Point2f(3, 9),
+                                         Point2f(0, 9)});
+        REQUIRE(roi.contains(Point2f(1, 8)));
+        REQUIRE(roi.contains(Point2f(8, 8)));
+        REQUIRE(roi.contains(Point2f(4.5, 1)));
+        REQUIRE_FALSE(roi.contains(Point2f(4.5, 6)));
+    }
+}
+
+TEST_CASE("Region of interest needs a polygon") {
+    REQUIRE_THROWS_AS(depthmapX::RegionOfInterest({Point2f(0, 0), Point2f(1, 1)}),
+                      depthmapX::RuntimeException);
+}
@@ -0,0 +1,143 @@
+// SPDX-FileCopyrightText: 2026 depthmapX authors
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "randomgraph.h"
+
+#include "depthmapXcli/brandeschoice.h"
+#include "depthmapXcli/sampledcentrality.h"
+#include "depthmapXcli/shortestpathsearch.h"
+
+#include "catch_amalgamated.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <set>
+
+namespace {
+    // the mean depth of every node from a search from each
+    std::vector<double> meanDepths(const depthmapX::CsrGraph &graph) {
+        auto reverse = graph.reversed();
+        depthmapX::ShortestPathSearch search(graph, reverse);
+        std::vector<double> meanDepths;
+        for (size_t v = 0; v < graph.numNodes(); v++) {
+            auto distances = search.distancesFrom({v}, false);
+            double totalDepth = 0;
+            for (double distance : distances) {
+                totalDepth += distance;
+            }
+            meanDepths.push_back(totalDepth / static_cast<double>(graph.numNodes() - 1));
+        }
+        return meanDepths;
+    }
+} // namespace
+
+TEST_CASE("Stratified origin sample") {
+    std::vector<Point2f> positions;
+    for (int x = 0; x < 20; x++) {
+        for (int y = 0; y < 20; y++) {
+            positions.push_back(Point2f(x, y));
+        }
+    }
+
+    SECTION("Every origin") {
+        auto sample = depthmapX::stratifiedSample(positions, 1.0, 1);
+        REQUIRE(sample.numStrata() == depthmapX::SAMPLE_GRID_SIDE * depthmapX::SAMPLE_GRID_SIDE);
+        REQUIRE(sample.origins.size() == positions.size());
+        std::set<size_t> origins(sample.origins.begin(), sample.origins.end());
+        REQUIRE(origins.size() == positions.size());
+    }
+
+    SECTION("A fraction from every stratum") {
+        auto sample = depthmapX::stratifiedSample(positions, 0.1, 7);
+        REQUIRE(sample.numStrata() == 16);
+        for (size_t h = 0; h < sample.numStrata(); h++) {
+            REQUIRE(sample.strataSizes[h] == 25);
+            // rounded from 2.5
+            REQUIRE(sample.strataStarts[h + 1] - sample.strataStarts[h] == 3);
+        }
+        REQUIRE(depthmapX::stratifiedSample(positions, 0.1, 7).origins == sample.origins);
+        REQUIRE(depthmapX::stratifiedSample(positions, 0.1, 8).origins != sample.origins);
+    }
+
+    SECTION("At least two origins per stratum") {
+        auto sample = depthmapX::stratifiedSample(positions, 0.001, 7);
+        REQUIRE(sample.origins.size() == 32);
+    }
+}
+
+TEST_CASE("Estimates from every origin are exact") {
+    auto graph = makeRandomGraph(60, 80, 5);
+    auto reverse = graph.reversed();
+    auto expectedMeanDepths = meanDepths(graph);
+    auto expectedChoice = depthmapX::brandesChoice(graph, 1);
+    std::vector<Point2f> positions;
+    for (size_t i = 0; i < graph.numNodes(); i++) {
+        positions.push_back(Point2f(static_cast<double>(i % 8), static_cast<double>(i / 8)));
+    }
+    auto sample = depthmapX::stratifiedSample(positions, 1.0, 1);
+    auto estimate = depthmapX::estimateCentrality(graph, reverse, 1, sample, true);
+    for (size_t v = 0; v < graph.numNodes(); v++) {
+        REQUIRE(estimate.nodeCount[v] == Catch::Approx(59));
+        REQUIRE(estimate.meanDepth[v] == Catch::Approx(expectedMeanDepths[v]));
+        REQUIRE(estimate.meanDepthError[v] == Catch::Approx(0).margin(1e-9));
+        REQUIRE(estimate.choice[v] == Catch::Approx(expectedChoice[v]));
+        REQUIRE(estimate.choiceError[v] == Catch::Approx(0).margin(1e-6));
+    }
+}
+
+TEST_CASE("Sampled estimates leave out the element itself") {
+    // every element is one step from every other, so that any sample of
+    // origins sees the same depths and gets them right if the element itself
+    // is left out of its own stratum, whether it is one of the origins or not
+    const size_t numNodes = 64;
+    depthmapX::CsrGraph graph;
+    std::vector<Point2f> positions;
+    for (size_t i = 0; i < numNodes; i++) {
+        std::vector<size_t> neighbours;
+        for (size_t j = 0; j < numNodes; j++) {
+            if (j != i) {
+                neighbours.push_back(j);
+            }
+        }
+        graph.addNode(neighbours);
+        positions.push_back(Point2f(static_cast<double>(i % 8), static_cast<double>(i / 8)));
+    }
+    auto sample = depthmapX::stratifiedSample(positions, 0.5, 3);
+    REQUIRE(sample.origins.size() == 32);
+    auto estimate = depthmapX::estimateCentrality(graph, graph.reversed(), 1, sample, false);
+    for (size_t v = 0; v < numNodes; v++) {
+        REQUIRE(estimate.nodeCount[v] == Catch::Approx(63));
+        REQUIRE(estimate.meanDepth[v] == Catch::Approx(1));
+        REQUIRE(estimate.meanDepthError[v] == Catch::Approx(0).margin(1e-9));
+    }
+}
+
+TEST_CASE("Sampled estimates are mostly within their confidence intervals") {
+    auto graph = makeRandomGraph(400, 300, 9);
+    auto reverse = graph.reversed();
+    auto expectedMeanDepths = meanDepths(graph);
+    std::vector<Point2f> positions;
+    for (size_t i = 0; i < graph.numNodes(); i++) {
+        positions.push_back(Point2f(static_cast<double>(i % 20), static_cast<double>(i / 20)));
+    }
+    auto sample = depthmapX::stratifiedSample(positions, 0.25, 1);
+    REQUIRE(sample.origins.size() < 110);
+    auto estimate = depthmapX::estimateCentrality(graph, reverse, 1, sample, false);
+    REQUIRE(estimate.choice.empty());
+    size_t covered = 0;
+    for (size_t v = 0; v < graph.numNodes(); v++) {
+        REQUIRE(estimate.meanDepthError[v] > 0);
+        if (std::abs(estimate.meanDepth[v] - expectedMeanDepths[v]) <= estimate.meanDepthError[v]) {
+            covered++;
+        }
+    }
+    REQUIRE(covered >= 360);
+}
+
+TEST_CASE("Integration HH") {
+    REQUIRE(depthmapX::integrationHH(1.0, 10) == -1);
+    REQUIRE(depthmapX::integrationHH(2.0, 2) == -1);
+    // RA = 2 * (3 - 1) / 8 = 0.5, D = 2 * (10 * (log2(4) - 1) + 1) / 72 = 22 / 72
+    REQUIRE(depthmapX::integrationHH(3.0, 10) == Catch::Approx(22.0 / 36.0));
+}
@@ -23,6 +23,11 @@ TEST_CASE("Test segment mode and help") {
                                 "       metric\n"
                                 "       angular\n"
                                 "  -sic to include choice (only for Tulip)\n"
+                                "  -sicb to include choice computed in the cli by Brandes "
+                                "accumulation over all\n"
+                                "       ordered pairs (only for Tulip at radius n, paths in the "
+                                "same bins share\n"
+                                "       each pair), as T<bins> Choice [Brandes]\n"
                                 "  -stb <tulip bins> (4 to 1024, 1024 approximates full angular)\n"
                                 "  -swa <map attribute name> perform weighted analysis using this "
                                 "attribute (only for Tulip)\n");
@@ -60,6 +65,12 @@ TEST_CASE("Test Segment Parsing Exceptions", "") {
         REQUIRE_THROWS_WITH(parser.parse(ah.argc(), ah.argv()), "Invalid SEGMENT radius type: foo");
     }
 
+    SECTION("Brandes choice without tulip") {
+        ArgumentHolder ah{"prog", "-st", "metric", "-sr", "n", "-sicb"};
+        REQUIRE_THROWS_WITH(parser.parse(ah.argc(), ah.argv()),
+                            "-stb, -srt, -sic and -sicb can only be used with tulip analysis");
+    }
+
     SECTION("Argument missing -stb") {
         ArgumentHolder ah{"prog", "-stb"};
         REQUIRE_THROWS_WITH(parser.parse(ah.argc(), ah.argv()), "-stb requires an argument");
@@ -151,10 +162,18 @@ TEST_CASE("Test segment mode parsing", "") {
                           "-srt", "steps", "-stb",  "1024", "-sic"};
         parser.parse(ah.argc(), ah.argv());
         REQUIRE(parser.includeChoice());
+        REQUIRE_FALSE(parser.brandesChoice());
         REQUIRE(parser.getTulipBins() == 1024);
         REQUIRE(parser.getAnalysisType() == SegmentParser::InAnalysisType::ANGULAR_TULIP);
         REQUIRE(parser.getRadiusType() == SegmentParser::InRadiusType::SEGMENT_STEPS);
         REQUIRE(parser.getRadii().size() == 1);
         REQUIRE(int(parser.getRadii()[0]) == -1);
     }
+    SECTION("Analysis Tulip with Brandes choice") {
+        ArgumentHolder ah{"prog", "-st",   "tulip", "-sr",  "n",
+                          "-srt", "steps", "-stb",  "1024", "-sicb"};
+        parser.parse(ah.argc(), ah.argv());
+        REQUIRE(parser.includeChoice());
+        REQUIRE(parser.brandesChoice());
+    }
 }
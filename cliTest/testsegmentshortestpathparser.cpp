@@ -3,11 +3,14 @@
 // SPDX-License-Identifier: GPL-3.0-or-later
 
 #include "argumentholder.h"
+#include "selfcleaningfile.h"
 
 #include "depthmapXcli/segmentshortestpathparser.h"
 
 #include "catch_amalgamated.hpp"
 
+#include <fstream>
+
 TEST_CASE("SegmentShortestPathParser", "Error cases") {
     SECTION("Missing argument to -sspo") {
         SegmentShortestPathParser parser;
@@ -90,3 +93,133 @@ TEST_CASE("Successful SegmentShortestPathParser", "Read successfully") {
     REQUIRE(destinationPoint.x == Catch::Approx(destinationX));
     REQUIRE(destinationPoint.y == Catch::Approx(destinationY));
 }
+
+TEST_CASE("SegmentShortestPathParser OD matrix", "Error cases") {
+    SECTION("OD file together with origin point") {
+        SegmentShortestPathParser parser;
+        ArgumentHolder ah{"prog", "-sspo", "0,0", "-sspf", "od.tsv", "-sspt", "metric"};
+        REQUIRE_THROWS_WITH(parser.parse(ah.argc(), ah.argv()),
+                            Catch::Matchers::ContainsSubstring(
+                                "-sspf cannot be used together with -sspo or -sspd"));
+    }
+
+    SECTION("A* for non-metric paths") {
+        SegmentShortestPathParser parser;
+        ArgumentHolder ah{"prog", "-sspf", "od.tsv", "-sspt", "tulip", "-sspa"};
+        REQUIRE_THROWS_WITH(parser.parse(ah.argc(), ah.argv()),
+                            Catch::Matchers::ContainsSubstring(
+                                "-sspa can only be used with metric shortest paths"));
+    }
+
+    SECTION("OD options without OD file") {
+        SegmentShortestPathParser parser;
+        ArgumentHolder ah{"prog", "-sspo", "0,0", "-sspd", "0,0", "-sspt", "metric", "-sspp"};
+        REQUIRE_THROWS_WITH(parser.parse(ah.argc(), ah.argv()),
+                            Catch::Matchers::ContainsSubstring(
+                                "-sspr, -sspa, -sspp and -sspc can only be used with -sspf"));
+    }
+
+    SECTION("Incremental options without OD file") {
+        SegmentShortestPathParser parser;
+        ArgumentHolder ah{"prog", "-sspo", "0,0", "-sspd", "0,0", "-sspt", "metric", "-sspi",
+                          "od.csv"};
+        REQUIRE_THROWS_WITH(
+            parser.parse(ah.argc(), ah.argv()),
+            Catch::Matchers::ContainsSubstring("-sspi and -sspib can only be used with -sspf"));
+    }
+
+    SECTION("Previous results without base graph") {
+        SegmentShortestPathParser parser;
+        ArgumentHolder ah{"prog", "-sspf", "od.tsv", "-sspt", "metric", "-sspp", "-sspi",
+                          "od.csv"};
+        REQUIRE_THROWS_WITH(
+            parser.parse(ah.argc(), ah.argv()),
+            Catch::Matchers::ContainsSubstring("-sspi and -sspib must be provided together"));
+    }
+
+    SECTION("Previous results without paths") {
+        SegmentShortestPathParser parser;
+        ArgumentHolder ah{"prog",  "-sspf",  "od.tsv", "-sspt",    "metric",
+                          "-sspi", "od.csv", "-sspib", "base.graph"};
+        REQUIRE_THROWS_WITH(
+            parser.parse(ah.argc(), ah.argv()),
+            Catch::Matchers::ContainsSubstring("-sspi can only be used with -sspp"));
+    }
+
+    SECTION("A* with contraction hierarchy") {
+        SegmentShortestPathParser parser;
+        ArgumentHolder ah{"prog", "-sspf", "od.tsv", "-sspt", "metric", "-sspa", "-sspc"};
+        REQUIRE_THROWS_WITH(
+            parser.parse(ah.argc(), ah.argv()),
+            Catch::Matchers::ContainsSubstring("-sspa cannot be used together with -sspc"));
+    }
+
+    SECTION("Contraction hierarchy without OD file") {
+        SegmentShortestPathParser parser;
+        ArgumentHolder ah{"prog", "-sspo", "0,0", "-sspd", "0,0", "-sspt", "metric", "-sspc"};
+        REQUIRE_THROWS_WITH(parser.parse(ah.argc(), ah.argv()),
+                            Catch::Matchers::ContainsSubstring(
+                                "-sspr, -sspa, -sspp and -sspc can only be used with -sspf"));
+    }
+
+    SECTION("Non-existing OD file") {
+        SegmentShortestPathParser parser;
+        ArgumentHolder ah{"prog", "-sspf", "foo.tsv", "-sspt", "metric"};
+        REQUIRE_THROWS_WITH(parser.parse(ah.argc(), ah.argv()),
+                            Catch::Matchers::ContainsSubstring("Failed to load file foo.tsv"));
+    }
+}
+
+TEST_CASE("Successful SegmentShortestPathParser OD matrix", "Read successfully") {
+    SegmentShortestPathParser parser;
+
+    SECTION("Coordinates") {
+        SelfCleaningFile scf("od.tsv");
+        {
+            std::ofstream f(scf.Filename().c_str());
+            f << "x1\ty1\tx2\ty2\n1\t2\t3\t4\n5\t6\t7\t8\n" << std::flush;
+        }
+        ArgumentHolder ah{"prog", "-sspf", scf.Filename(), "-sspt", "metric", "-sspa", "-sspp"};
+        parser.parse(ah.argc(), ah.argv());
+        REQUIRE(parser.isODMatrix());
+        REQUIRE(parser.useAStar());
+        REQUIRE(parser.outputPaths());
+        REQUIRE_FALSE(parser.useHierarchy());
+        REQUIRE(parser.getODLines().size() == 2);
+        REQUIRE(parser.getODLines()[1].start().x == Catch::Approx(5.0));
+        REQUIRE(parser.getODLines()[1].end().y == Catch::Approx(8.0));
+        REQUIRE(parser.getODRefPairs().empty());
+    }
+
+    SECTION("Refs") {
+        SelfCleaningFile scf("od.tsv");
+        {
+            std::ofstream f(scf.Filename().c_str());
+            f << "reffrom\trefto\n1\t2\n3\t4\n5\t6\n" << std::flush;
+        }
+        ArgumentHolder ah{"prog", "-sspf", scf.Filename(), "-sspr", "-sspt", "tulip", "-sspc"};
+        parser.parse(ah.argc(), ah.argv());
+        REQUIRE(parser.isODMatrix());
+        REQUIRE_FALSE(parser.useAStar());
+        REQUIRE_FALSE(parser.outputPaths());
+        REQUIRE(parser.useHierarchy());
+        REQUIRE(parser.getODLines().empty());
+        REQUIRE(parser.getODRefPairs().size() == 3);
+        REQUIRE(parser.getODRefPairs()[2] == std::pair<int, int>(5, 6));
+        REQUIRE_FALSE(parser.isIncremental());
+    }
+
+    SECTION("Incremental") {
+        SelfCleaningFile scf("od.tsv");
+        {
+            std::ofstream f(scf.Filename().c_str());
+            f << "reffrom\trefto\n1\t2\n" << std::flush;
+        }
+        ArgumentHolder ah{"prog",  "-sspf", scf.Filename(), "-sspr",  "-sspt",    "metric",
+                          "-sspp", "-sspi", "od.csv",       "-sspib", "base.graph"};
+        parser.parse(ah.argc(), ah.argv());
+        REQUIRE(parser.isIncremental());
+        REQUIRE(parser.getPreviousResultsFile() == "od.csv");
+        REQUIRE(parser.getBaseGraphFile() == "base.graph");
+    }
+}
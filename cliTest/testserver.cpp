@@ -0,0 +1,145 @@
+// SPDX-FileCopyrightText: 2026 depthmapX authors
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "depthmapXcli/imodeparser.h"
+#include "depthmapXcli/imodeparserfactory.h"
+#include "depthmapXcli/server.h"
+
+#include "selfcleaningfile.h"
+
+#include "catch_amalgamated.hpp"
+
+#include <iostream>
+
+#ifndef _WIN32
+#include <csignal>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <chrono>
+#include <cstring>
+#include <thread>
+#endif
+
+TEST_CASE("Server request parsing") {
+    REQUIRE(dm_server::splitRequest("-m\tVGA\t-f\tin file.graph\t\t-o\tout.graph") ==
+            std::vector<std::string>{"-m", "VGA", "-f", "in file.graph", "-o", "out.graph"});
+    REQUIRE(dm_server::splitRequest("").empty());
+    REQUIRE(dm_server::requestInputFile({"-m", "VGA", "-f", "in.graph", "-o", "out.graph"}) ==
+            "in.graph");
+    REQUIRE(dm_server::requestInputFile({"-m", "VGA", "-f"}).empty());
+}
+
+#ifndef _WIN32
+namespace {
+    class EchoParser : public IModeParser {
+      public:
+        std::string getModeName() const override { return "ECHO"; }
+        std::string getHelp() const override { return ""; }
+        void parse(size_t, char **) override {}
+        void run(const CommandLineParser &, IPerformanceSink &) const override {
+            std::cout << "echo running\n";
+        }
+    };
+
+    class EchoFactory : public IModeParserFactory {
+      public:
+        EchoFactory() { m_parsers.push_back(std::unique_ptr<IModeParser>(new EchoParser)); }
+        const ModeParserVec &getModeParsers() const override { return m_parsers; }
+
+      private:
+        ModeParserVec m_parsers;
+    };
+
+    int connectTo(const std::string &socketPath) {
+        sockaddr_un address{};
+        address.sun_family = AF_UNIX;
+        std::strncpy(address.sun_path, socketPath.c_str(), sizeof(address.sun_path) - 1);
+        int connection = socket(AF_UNIX, SOCK_STREAM, 0);
+        // the server may still be starting
+        for (int attempt = 0; attempt < 500; attempt++) {
+            if (connect(connection, reinterpret_cast<sockaddr *>(&address), sizeof(address)) ==
+                0) {
+                break;
+            }
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        }
+        return connection;
+    }
+
+    std::string request(const std::string &socketPath, const std::string &line) {
+        int connection = connectTo(socketPath);
+        std::string message = line + "\n";
+        REQUIRE(write(connection, message.c_str(), message.size()) ==
+                static_cast<ssize_t>(message.size()));
+        std::string response;
+        char buffer[256];
+        ssize_t received;
+        while ((received = read(connection, buffer, sizeof(buffer))) > 0) {
+            response.append(buffer, static_cast<size_t>(received));
+        }
+        close(connection);
+        return response;
+    }
+} // namespace
+
+TEST_CASE("Server runs requests") {
+    SelfCleaningFile socketFile("testserver.socket");
+    EchoFactory factory;
+    pid_t server = fork();
+    if (server == 0) {
+        try {
+            dm_server::serve(socketFile.Filename(), 1, factory);
+        } catch (...) {
+        }
+        _exit(1);
+    }
+    REQUIRE(server > 0);
+
+    std::string response =
+        request(socketFile.Filename(), "-m\tECHO\t-f\tnonexisting.graph\t-o\tout.graph");
+    REQUIRE(response.find("echo running\n") != std::string::npos);
+    REQUIRE(response.size() >= 13);
+    REQUIRE(response.substr(response.size() - 13) == "OK out.graph\n");
+
+    response = request(socketFile.Filename(), "-m\tNOPE\t-f\tin.graph\t-o\tout.graph");
+    REQUIRE(response == "\nERROR Invalid mode: NOPE\n");
+
+    kill(server, SIGTERM);
+    waitpid(server, nullptr, 0);
+}
+
+TEST_CASE("Server disconnects idle clients") {
+    SelfCleaningFile socketFile("testserveridle.socket");
+    EchoFactory factory;
+    pid_t server = fork();
+    if (server == 0) {
+        try {
+            dm_server::serve(socketFile.Filename(), 1, factory, std::chrono::milliseconds(200));
+        } catch (...) {
+        }
+        _exit(1);
+    }
+    REQUIRE(server > 0);
+
+    // connects and sends nothing, which must not keep the next request waiting
+    // for longer than the timeout
+    int idle = connectTo(socketFile.Filename());
+    auto start = std::chrono::steady_clock::now();
+    std::string response =
+        request(socketFile.Filename(), "-m\tECHO\t-f\tnonexisting.graph\t-o\tout.graph");
+    REQUIRE(response.substr(response.size() - 13) == "OK out.graph\n");
+    REQUIRE(std::chrono::steady_clock::now() - start < std::chrono::seconds(5));
+
+    // and the idle client finds its connection closed
+    char buffer[16];
+    REQUIRE(read(idle, buffer, sizeof(buffer)) == 0);
+    close(idle);
+
+    kill(server, SIGTERM);
+    waitpid(server, nullptr, 0);
+}
+#endif
@@ -0,0 +1,225 @@
+// SPDX-FileCopyrightText: 2026 depthmapX authors
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "depthmapXcli/shortestpathsearch.h"
+
+#include "catch_amalgamated.hpp"
+
+#include <cmath>
+#include <queue>
+#include <random>
+
+namespace {
+    // nodes on a jittered 10x10 lattice, with directed edges to the right and
+    // upwards neighbours weighted by their euclidean distance plus a detour
+    struct Lattice {
+        depthmapX::CsrGraph graph;
+        std::vector<std::pair<double, double>> positions;
+    };
+
+    Lattice makeLattice(unsigned int seed) {
+        const size_t side = 10;
+        std::mt19937 generator(seed);
+        std::uniform_real_distribution<double> jitter(-0.3, 0.3);
+        std::uniform_real_distribution<double> detour(0.0, 2.0);
+        Lattice lattice;
+        for (size_t i = 0; i < side * side; i++) {
+            lattice.positions.push_back({static_cast<double>(i % side) + jitter(generator),
+                                         static_cast<double>(i / side) + jitter(generator)});
+        }
+        auto distance = [&lattice](size_t a, size_t b) {
+            return std::hypot(lattice.positions[a].first - lattice.positions[b].first,
+                              lattice.positions[a].second - lattice.positions[b].second);
+        };
+        for (size_t i = 0; i < side * side; i++) {
+            std::vector<std::pair<size_t, float>> neighbours;
+            if (i % side != side - 1) {
+                neighbours.push_back({i + 1, static_cast<float>(distance(i, i + 1) +
+                                                                detour(generator))});
+            }
+            if (i / side != side - 1) {
+                neighbours.push_back({i + side, static_cast<float>(distance(i, i + side) +
+                                                                   detour(generator))});
+            }
+            lattice.graph.addNode(neighbours);
+        }
+        return lattice;
+    }
+
+    double dijkstra(const depthmapX::CsrGraph &graph, size_t source, size_t target) {
+        std::vector<double> dist(graph.numNodes(), -1);
+        typedef std::pair<double, size_t> Entry;
+        std::priority_queue<Entry, std::vector<Entry>, std::greater<Entry>> queue;
+        queue.push({0, source});
+        while (!queue.empty()) {
+            auto [distance, node] = queue.top();
+            queue.pop();
+            if (dist[node] >= 0) {
+                continue;
+            }
+            dist[node] = distance;
+            for (size_t e = graph.offsets[node]; e < graph.offsets[node + 1]; e++) {
+                queue.push({distance + static_cast<double>(graph.weights[e]), graph.targets[e]});
+            }
+        }
+        return dist[target];
+    }
+
+    double pathLength(const depthmapX::CsrGraph &graph, const std::vector<size_t> &nodes) {
+        double length = 0;
+        for (size_t i = 1; i < nodes.size(); i++) {
+            bool found = false;
+            for (size_t e = graph.offsets[nodes[i - 1]]; e < graph.offsets[nodes[i - 1] + 1];
+                 e++) {
+                if (graph.targets[e] == nodes[i]) {
+                    length += static_cast<double>(graph.weights[e]);
+                    found = true;
+                    break;
+                }
+            }
+            REQUIRE(found);
+        }
+        return length;
+    }
+} // namespace
+
+TEST_CASE("Reversed CsrGraph") {
+    depthmapX::CsrGraph graph;
+    graph.addNode(std::vector<std::pair<size_t, float>>{{1, 1.5f}, {2, 2.5f}});
+    graph.addNode(std::vector<std::pair<size_t, float>>{{2, 3.5f}});
+    graph.addNode(std::vector<std::pair<size_t, float>>{});
+
+    auto reverse = graph.reversed();
+    REQUIRE(reverse.numNodes() == 3);
+    REQUIRE(reverse.numEdges() == 3);
+    REQUIRE(reverse.degree(0) == 0);
+    REQUIRE(reverse.degree(1) == 1);
+    REQUIRE(reverse.targets[reverse.offsets[1]] == 0);
+    REQUIRE(reverse.weights[reverse.offsets[1]] == 1.5f);
+    REQUIRE(reverse.degree(2) == 2);
+    REQUIRE(reverse.targets[reverse.offsets[2]] == 0);
+    REQUIRE(reverse.weights[reverse.offsets[2]] == 2.5f);
+    REQUIRE(reverse.targets[reverse.offsets[2] + 1] == 1);
+    REQUIRE(reverse.weights[reverse.offsets[2] + 1] == 3.5f);
+}
+
+TEST_CASE("Point to point searches agree with Dijkstra") {
+    auto lattice = makeLattice(42);
+    auto &graph = lattice.graph;
+    auto reverse = graph.reversed();
+    depthmapX::ShortestPathSearch search(graph, reverse);
+
+    auto heuristic = [&lattice](size_t target) {
+        return [&lattice, target](size_t node) {
+            return std::hypot(lattice.positions[node].first - lattice.positions[target].first,
+                              lattice.positions[node].second - lattice.positions[target].second);
+        };
+    };
+
+    std::mt19937 generator(7);
+    std::uniform_int_distribution<size_t> pick(0, graph.numNodes() - 1);
+    for (int query = 0; query < 200; query++) {
+        size_t source = pick(generator);
+        size_t target = pick(generator);
+        double expected = dijkstra(graph, source, target);
+
+        auto bidirectional = search.bidirectional({source}, {target}, true);
+        auto aStar = search.aStar({source}, {target}, heuristic(target), true);
+        if (expected < 0) {
+            REQUIRE_FALSE(bidirectional.found());
+            REQUIRE_FALSE(aStar.found());
+            continue;
+        }
+        REQUIRE(bidirectional.distance == Catch::Approx(expected));
+        REQUIRE(aStar.distance == Catch::Approx(expected));
+        REQUIRE(bidirectional.nodes.front() == source);
+        REQUIRE(bidirectional.nodes.back() == target);
+        REQUIRE(pathLength(graph, bidirectional.nodes) == Catch::Approx(expected));
+        REQUIRE(aStar.nodes.front() == source);
+        REQUIRE(aStar.nodes.back() == target);
+        REQUIRE(pathLength(graph, aStar.nodes) == Catch::Approx(expected));
+    }
+}
+
+TEST_CASE("Point to point searches between node sets") {
+    // 0 -> 1 -> 2 -> 3, and 4 -> 3 as a cheaper alternative source
+    depthmapX::CsrGraph graph;
+    graph.addNode(std::vector<std::pair<size_t, float>>{{1, 1.0f}});
+    graph.addNode(std::vector<std::pair<size_t, float>>{{2, 1.0f}});
+    graph.addNode(std::vector<std::pair<size_t, float>>{{3, 1.0f}});
+    graph.addNode(std::vector<std::pair<size_t, float>>{});
+    graph.addNode(std::vector<std::pair<size_t, float>>{{3, 0.5f}});
+    auto reverse = graph.reversed();
+    depthmapX::ShortestPathSearch search(graph, reverse);
+
+    auto result = search.bidirectional({0, 4}, {3}, true);
+    REQUIRE(result.distance == Catch::Approx(0.5));
+    REQUIRE(result.nodes == std::vector<size_t>{4, 3});
+
+    result = search.bidirectional({0}, {2, 3}, false);
+    REQUIRE(result.distance == Catch::Approx(2.0));
+    REQUIRE(result.nodes.empty());
+
+    result = search.bidirectional({1}, {1}, true);
+    REQUIRE(result.distance == 0);
+    REQUIRE(result.nodes == std::vector<size_t>{1});
+
+    result = search.bidirectional({3}, {0}, true);
+    REQUIRE_FALSE(result.found());
+
+    result = search.aStar({3}, {0}, [](size_t) { return 0.0; }, true);
+    REQUIRE_FALSE(result.found());
+}
+
+TEST_CASE("Distances from a node to all others agree with Dijkstra") {
+    auto lattice = makeLattice(11);
+    auto &graph = lattice.graph;
+    auto reverse = graph.reversed();
+    depthmapX::ShortestPathSearch search(graph, reverse);
+
+    for (size_t source : {size_t(0), size_t(37), size_t(99)}) {
+        auto forwards = search.distancesFrom({source}, false);
+        auto backwards = search.distancesFrom({source}, true);
+        for (size_t node = 0; node < graph.numNodes(); node++) {
+            double from = dijkstra(graph, source, node);
+            double to = dijkstra(graph, node, source);
+            if (from < 0) {
+                REQUIRE(std::isinf(forwards[node]));
+            } else {
+                REQUIRE(forwards[node] == Catch::Approx(from));
+            }
+            if (to < 0) {
+                REQUIRE(std::isinf(backwards[node]));
+            } else {
+                REQUIRE(backwards[node] == Catch::Approx(to));
+            }
+        }
+    }
+}
+
+TEST_CASE("Unweighted searches agree with searches of unit weights") {
+    auto unitWeights = makeLattice(13).graph;
+    std::fill(unitWeights.weights.begin(), unitWeights.weights.end(), 1.0f);
+    auto unweighted = unitWeights;
+    unweighted.weights.clear();
+    auto unitReverse = unitWeights.reversed();
+    auto unweightedReverse = unweighted.reversed();
+    depthmapX::ShortestPathSearch unitSearch(unitWeights, unitReverse);
+    depthmapX::ShortestPathSearch unweightedSearch(unweighted, unweightedReverse);
+
+    for (size_t source : {size_t(0), size_t(37), size_t(99)}) {
+        for (bool reverse : {false, true}) {
+            REQUIRE(unweightedSearch.distancesFrom({source, 55}, reverse) ==
+                    unitSearch.distancesFrom({source, 55}, reverse));
+        }
+        for (size_t target : {size_t(0), size_t(64), size_t(99)}) {
+            auto expected = unitSearch.bidirectional({source}, {target}, false);
+            REQUIRE(unweightedSearch.bidirectional({source}, {target}, false).distance ==
+                    expected.distance);
+            auto result = unweightedSearch.aStar({source}, {target}, [](size_t) { return 0.0; },
+                                                 false);
+            REQUIRE(result.distance == expected.distance);
+        }
+    }
+}
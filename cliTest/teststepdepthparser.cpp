@@ -7,6 +7,8 @@
 
 #include "depthmapXcli/stepdepthparser.h"
 
+#include "salalib/genlib/exceptions.h"
+
 #include "catch_amalgamated.hpp"
 
 #include <fstream>
@@ -143,6 +145,7 @@ TEST_CASE("StepDepthParserSuccess", "Read successfully") {
         parser.parse(ah.argc(), ah.argv());
     }
 
+    REQUIRE_FALSE(parser.isMultiSource());
     auto points = parser.getStepDepthPoints();
     REQUIRE(points.size() == 2);
     REQUIRE(points[0].x == Catch::Approx(x1));
@@ -150,3 +153,49 @@ TEST_CASE("StepDepthParserSuccess", "Read successfully") {
     REQUIRE(points[1].x == Catch::Approx(x2));
     REQUIRE(points[1].y == Catch::Approx(y2));
 }
+
+TEST_CASE("StepDepthParserMultiSource", "Read multi-source flag") {
+    StepDepthParser parser;
+    ArgumentHolder ah{"prog", "-sdp", "1.0,2.0", "-sdp", "1.1,1.2", "-sdt", "visual", "-sdm"};
+    parser.parse(ah.argc(), ah.argv());
+    REQUIRE(parser.isMultiSource());
+    REQUIRE(parser.getStepDepthPoints().size() == 2);
+    REQUIRE(parser.getStepType() == StepDepthParser::StepType::VISUAL);
+}
+
+TEST_CASE("StepDepthParserGroups", "Read origin groups from the point file") {
+    StepDepthParser parser;
+    SelfCleaningFile scf("testpointgroups.csv");
+
+    SECTION("Points with a group column") {
+        {
+            std::ofstream f(scf.Filename().c_str());
+            f << "x\ty\tGroup\n1\t2\tentrance\n1.1\t1.2\texit\n3\t4\tentrance\n" << std::flush;
+        }
+        ArgumentHolder ah{"prog", "-sdf", scf.Filename(), "-sdt", "visual", "-sdm"};
+        parser.parse(ah.argc(), ah.argv());
+        REQUIRE(parser.getStepDepthPoints().size() == 3);
+        REQUIRE(parser.getStepDepthGroups() ==
+                std::vector<std::string>{"entrance", "exit", "entrance"});
+    }
+
+    SECTION("Points without a group column") {
+        {
+            std::ofstream f(scf.Filename().c_str());
+            f << "x\ty\n1\t2\n1.1\t1.2\n" << std::flush;
+        }
+        ArgumentHolder ah{"prog", "-sdf", scf.Filename(), "-sdt", "visual", "-sdm"};
+        parser.parse(ah.argc(), ah.argv());
+        REQUIRE(parser.getStepDepthPoints().size() == 2);
+        REQUIRE(parser.getStepDepthGroups().empty());
+    }
+
+    SECTION("Point without a group") {
+        {
+            std::ofstream f(scf.Filename().c_str());
+            f << "x\ty\tgroup\n1\t2\tentrance\n1.1\t1.2\n" << std::flush;
+        }
+        ArgumentHolder ah{"prog", "-sdf", scf.Filename(), "-sdt", "visual", "-sdm"};
+        REQUIRE_THROWS_AS(parser.parse(ah.argc(), ah.argv()), depthmapX::RuntimeException);
+    }
+}
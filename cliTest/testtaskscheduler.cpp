@@ -0,0 +1,114 @@
+// SPDX-FileCopyrightText: 2026 depthmapX authors
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "depthmapXcli/taskscheduler.h"
+
+#include "catch_amalgamated.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+TEST_CASE("TaskScheduler parallelFor") {
+    auto numThreads = GENERATE(1, 4);
+    auto grainSize = GENERATE(0, 1, 7, 1000);
+    depthmapX::TaskScheduler scheduler(static_cast<size_t>(numThreads));
+    REQUIRE(scheduler.numThreads() == static_cast<size_t>(numThreads));
+
+    // Catch assertions are not thread safe, so the ranges are checked after
+    std::vector<std::atomic<int>> visits(500);
+    std::atomic<size_t> largestRange(0);
+    scheduler.parallelFor(3, visits.size(), static_cast<size_t>(grainSize),
+                          [&visits, &largestRange](size_t begin, size_t end) {
+                              size_t range = end - begin;
+                              size_t largest = largestRange;
+                              while (range > largest &&
+                                     !largestRange.compare_exchange_weak(largest, range)) {
+                              }
+                              for (size_t i = begin; i < end; i++) {
+                                  visits[i]++;
+                              }
+                          });
+    REQUIRE(largestRange == std::min<size_t>(497, std::max(1, grainSize)));
+    for (size_t i = 0; i < visits.size(); i++) {
+        REQUIRE(visits[i] == (i < 3 ? 0 : 1));
+    }
+
+    // empty range
+    bool run = false;
+    scheduler.parallelFor(5, 5, 1, [&run](size_t, size_t) { run = true; });
+    REQUIRE_FALSE(run);
+}
+
+TEST_CASE("TaskScheduler nested groups") {
+    depthmapX::TaskScheduler scheduler(2);
+    std::atomic<int> total(0);
+    scheduler.parallelFor(0, 8, 1, [&scheduler, &total](size_t, size_t) {
+        scheduler.parallelFor(0, 100, 10, [&total](size_t begin, size_t end) {
+            total += static_cast<int>(end - begin);
+        });
+    });
+    REQUIRE(total == 800);
+}
+
+TEST_CASE("TaskGroup waits for tasks running on other threads") {
+    // the waiting thread runs out of queued tasks while the workers still run
+    // theirs, so it has to be woken by the last of them, again and again to
+    // catch a missed wake up
+    depthmapX::TaskScheduler scheduler(4);
+    for (int round = 0; round < 1000; round++) {
+        depthmapX::TaskGroup group(scheduler);
+        std::atomic<int> started(0);
+        std::atomic<int> finished(0);
+        for (int i = 0; i < 3; i++) {
+            group.spawn([&started, &finished]() {
+                started++;
+                // held until all three run at once, one on each thread
+                while (started < 3) {
+                    std::this_thread::yield();
+                }
+                finished++;
+            });
+        }
+        group.wait();
+        REQUIRE(finished == 3);
+    }
+}
+
+TEST_CASE("TaskGroup exceptions and cancellation") {
+    depthmapX::TaskScheduler scheduler(1);
+
+    SECTION("Exception is rethrown and cancels the group") {
+        depthmapX::TaskGroup group(scheduler);
+        std::atomic<int> run(0);
+        for (int i = 0; i < 10; i++) {
+            group.spawn([&run]() {
+                run++;
+                throw std::runtime_error("task failed");
+            });
+        }
+        REQUIRE_THROWS_WITH(group.wait(), "task failed");
+        REQUIRE(run == 1);
+        REQUIRE(group.isCancelled());
+    }
+
+    SECTION("Cancelled group skips its tasks") {
+        depthmapX::TaskGroup group(scheduler);
+        std::atomic<int> run(0);
+        group.parallelFor(0, 4, 1, [&run, &group](size_t, size_t) {
+            run++;
+            group.cancel();
+        });
+        REQUIRE(run == 1);
+    }
+}
+
+TEST_CASE("Global TaskScheduler") {
+    depthmapX::TaskScheduler::setGlobalThreads(3);
+    REQUIRE(depthmapX::TaskScheduler::global().numThreads() == 3);
+    depthmapX::TaskScheduler::setGlobalThreads(0);
+    REQUIRE(depthmapX::TaskScheduler::global().numThreads() >= 1);
+}
@@ -65,6 +65,15 @@ TEST_CASE("VGA args invalid", "") {
             p.parse(ah.argc(), ah.argv()),
             Catch::Matchers::ContainsSubstring("Metric vga requires a radius, use -vr <radius>"));
     }
+
+    {
+        ArgumentHolder ah{"prog", "-f", "infile", "-o", "outfile", "-m", "VGA", "-vm", "isovist",
+                          "-vlb"};
+        VgaParser p;
+        REQUIRE_THROWS_WITH(p.parse(ah.argc(), ah.argv()),
+                            Catch::Matchers::ContainsSubstring(
+                                "-vlb can only be used with visibility analysis"));
+    }
 }
 
 TEST_CASE("VGA args valid", "valid") {
@@ -101,9 +110,21 @@ TEST_CASE("VGA args valid", "valid") {
         REQUIRE(cmdP.getVgaMode() == VgaParser::VgaMode::VISBILITY);
         REQUIRE(cmdP.globalMeasures());
         REQUIRE(cmdP.localMeasures());
+        REQUIRE_FALSE(cmdP.bitsetLocalMeasures());
         REQUIRE(cmdP.getRadius() == "4");
     }
 
+    {
+        ArgumentHolder ah{"prog", "-f",  "infile", "-o",         "outfile",
+                          "-m",   "VGA", "-vm",    "visibility", "-vlb"};
+        VgaParser cmdP;
+        cmdP.parse(ah.argc(), ah.argv());
+        REQUIRE(cmdP.getVgaMode() == VgaParser::VgaMode::VISBILITY);
+        REQUIRE_FALSE(cmdP.globalMeasures());
+        REQUIRE(cmdP.localMeasures());
+        REQUIRE(cmdP.bitsetLocalMeasures());
+    }
+
     {
         ArgumentHolder ah{"prog", "-f",  "infile", "-o",        "outfile",
                           "-m",   "VGA", "-vm",    "thruvision"};
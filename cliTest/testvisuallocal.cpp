@@ -0,0 +1,107 @@
+// SPDX-FileCopyrightText: 2026 depthmapX authors
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "depthmapXcli/visuallocal.h"
+
+#include "catch_amalgamated.hpp"
+
+#include <random>
+#include <set>
+
+namespace {
+    // symmetric, with some duplicate edges and self loops thrown in
+    depthmapX::CsrGraph makeRandomGraph(size_t numNodes, size_t numEdges, unsigned int seed) {
+        std::mt19937 generator(seed);
+        std::vector<std::vector<size_t>> edges(numNodes);
+        for (size_t e = 0; e < numEdges; e++) {
+            size_t a = generator() % numNodes;
+            size_t b = generator() % numNodes;
+            edges[a].push_back(b);
+            edges[b].push_back(a);
+        }
+        depthmapX::CsrGraph graph;
+        for (const auto &nodeEdges : edges) {
+            graph.addNode(nodeEdges);
+        }
+        return graph;
+    }
+
+    // the measures straight from their definitions
+    depthmapX::VisualLocalMeasures naiveMeasures(const depthmapX::CsrGraph &graph) {
+        std::vector<std::set<size_t>> hoods(graph.numNodes());
+        for (size_t v = 0; v < graph.numNodes(); v++) {
+            for (size_t e = graph.offsets[v]; e < graph.offsets[v + 1]; e++) {
+                if (graph.targets[e] != v) {
+                    hoods[v].insert(graph.targets[e]);
+                }
+            }
+        }
+        depthmapX::VisualLocalMeasures measures;
+        for (size_t v = 0; v < graph.numNodes(); v++) {
+            double k = static_cast<double>(hoods[v].size());
+            double linked = 0;
+            double control = 0;
+            std::set<size_t> reach = hoods[v];
+            reach.insert(v);
+            for (size_t j : hoods[v]) {
+                for (size_t u : hoods[j]) {
+                    linked += static_cast<double>(hoods[v].count(u));
+                    reach.insert(u);
+                }
+                control += 1.0 / static_cast<double>(hoods[j].size() + 1);
+            }
+            measures.clustering.push_back(k > 1 ? linked / (k * (k - 1)) : -1);
+            measures.control.push_back(k > 0 ? control : -1);
+            measures.controllability.push_back(k > 0 ? (k + 1) / static_cast<double>(reach.size())
+                                                     : -1);
+        }
+        return measures;
+    }
+
+    void requireSame(const depthmapX::VisualLocalMeasures &measures,
+                     const depthmapX::VisualLocalMeasures &expected) {
+        REQUIRE(measures.clustering.size() == expected.clustering.size());
+        for (size_t v = 0; v < expected.clustering.size(); v++) {
+            REQUIRE(measures.clustering[v] == Catch::Approx(expected.clustering[v]));
+            REQUIRE(measures.control[v] == Catch::Approx(expected.control[v]));
+            REQUIRE(measures.controllability[v] == Catch::Approx(expected.controllability[v]));
+        }
+    }
+} // namespace
+
+TEST_CASE("Visual local measures of a small graph") {
+    // a triangle 0, 1, 2 with 3 hanging off 2 and 4 on its own
+    depthmapX::CsrGraph graph;
+    graph.addNode(std::vector<size_t>{1, 2});
+    graph.addNode(std::vector<size_t>{0, 2});
+    graph.addNode(std::vector<size_t>{0, 1, 3});
+    graph.addNode(std::vector<size_t>{2});
+    graph.addNode(std::vector<size_t>{});
+    auto measures = depthmapX::visualLocalMeasures(graph);
+    REQUIRE(measures.clustering == std::vector<double>{1, 1, 1.0 / 3.0, -1, -1});
+    REQUIRE(measures.control[0] == Catch::Approx(1.0 / 3.0 + 1.0 / 4.0));
+    REQUIRE(measures.control[3] == Catch::Approx(1.0 / 4.0));
+    REQUIRE(measures.control[4] == -1);
+    REQUIRE(measures.controllability[0] == Catch::Approx(3.0 / 4.0));
+    REQUIRE(measures.controllability[3] == Catch::Approx(2.0 / 4.0));
+    REQUIRE(measures.controllability[4] == -1);
+}
+
+TEST_CASE("Visual local measures with and without bitsets") {
+    auto graph = makeRandomGraph(300, 6000, 3);
+    auto expected = naiveMeasures(graph);
+
+    SECTION("Every neighbourhood walked") {
+        requireSame(depthmapX::visualLocalMeasures(graph, 0), expected);
+    }
+
+    SECTION("Some neighbourhoods in bitsets") {
+        // five bitsets of five words
+        requireSame(depthmapX::visualLocalMeasures(graph, 5 * 5 * 8), expected);
+    }
+
+    SECTION("All dense neighbourhoods in bitsets") {
+        requireSame(depthmapX::visualLocalMeasures(graph), expected);
+    }
+}
@@ -5,6 +5,7 @@
 #include "axialparser.h"
 
 #include "exceptions.h"
+#include "graphbuilders.h"
 #include "parsingutils.h"
 #include "runmethods.h"
 #include "simpletimer.h"
@@ -16,7 +17,8 @@
 using namespace depthmapX;
 
 AxialParser::AxialParser()
-    : m_runFewestLines(false), m_runAnalysis(false), m_choice(false), m_local(false), m_rra(false) {
+    : m_runFewestLines(false), m_runAnalysis(false), m_choice(false), m_brandesChoice(false),
+      m_local(false), m_rra(false) {
 
 }
 
@@ -33,6 +35,9 @@ std::string AxialParser::getHelp() const {
            "-aa -af -au -ax\n"
            " Further flags for axial analysis are:\n"
            "   -xac Include choice (betweenness)\n"
+           "   -xacb Include choice computed in the cli by Brandes accumulation over all\n"
+           "         ordered pairs (radius n only, paths of equal depth share each pair),\n"
+           "         as Choice [Brandes]\n"
            "   -xal Include local measures\n"
            "   -xar Include RA, RRA and total depth\n"
            "   -xaw <map attribute name> perform weighted analysis using this attribute\n"
@@ -57,6 +62,9 @@ void AxialParser::parse(size_t argc, char **argv) {
             m_local = true;
         } else if (std::strcmp(argv[i], "-xac") == 0) {
             m_choice = true;
+        } else if (std::strcmp(argv[i], "-xacb") == 0) {
+            m_choice = true;
+            m_brandesChoice = true;
         } else if (std::strcmp(argv[i], "-xar") == 0) {
             m_rra = true;
         } else if (std::strcmp(argv[i], "-xaw") == 0) {
@@ -71,6 +79,10 @@ void AxialParser::parse(size_t argc, char **argv) {
 }
 
 void AxialParser::run(const CommandLineParser &clp, IPerformanceSink &perfWriter) const {
+    std::string productKey;
+    if (dm_runmethods::fetchCachedProduct(clp, perfWriter, productKey)) {
+        return;
+    }
     auto metaGraph = dm_runmethods::loadGraph(clp.getFileName().c_str(), perfWriter);
 
     std::optional<std::string> mimicVersion = clp.getMimickVersion();
@@ -111,7 +123,8 @@ void AxialParser::run(const CommandLineParser &clp, IPerformanceSink &perfWriter
         Options options;
         const std::vector<double> &radii = getRadii();
         options.radiusSet.insert(radii.begin(), radii.end());
-        options.choice = useChoice();
+        // with -xacb choice is accumulated here instead of by salalib
+        options.choice = useChoice() && !useBrandesChoice();
         options.local = useLocal();
         options.fulloutput = calculateRRA();
         options.weightedMeasureCol = -1;
@@ -130,10 +143,36 @@ void AxialParser::run(const CommandLineParser &clp, IPerformanceSink &perfWriter
             }
         }
 
-        DO_TIMED(
-            "Axial analysis",
-            metaGraph.analyseAxial(dm_runmethods::getCommunicator(clp).get(), options,
-                                   (mimicVersion.has_value() && mimicVersion == "depthmapX 0.8.0")))
+        if (useBrandesChoice() &&
+            (getRadii() != std::vector<double>{-1.0} || !getAttribute().empty())) {
+            throw depthmapX::RuntimeException("-xacb requires radius n without -xaw");
+        }
+
+        if (clp.getSampleFraction() > 0) {
+            if (getRadii() != std::vector<double>{-1.0} || useLocal() || calculateRRA() ||
+                !getAttribute().empty()) {
+                throw depthmapX::RuntimeException(
+                    "Sampled axial analysis (-sa) requires radius n without -xal, -xar or -xaw");
+            }
+            auto &map = metaGraph.getDisplayedShapeGraph();
+            std::vector<int> shapeRefs;
+            std::vector<Point2f> midpoints;
+            auto graph = dm_graphbuilders::axialGraph(map.getInternalMap(), shapeRefs, &midpoints);
+            dm_runmethods::runSampledCentrality(clp, perfWriter, graph, 1, midpoints, shapeRefs,
+                                                useChoice(), true, "", map.getAttributeTable());
+        } else {
+            DO_TIMED("Axial analysis",
+                     metaGraph.analyseAxial(
+                         dm_runmethods::getCommunicator(clp).get(), options,
+                         (mimicVersion.has_value() && mimicVersion == "depthmapX 0.8.0")))
+            if (useBrandesChoice()) {
+                auto &map = metaGraph.getDisplayedShapeGraph();
+                std::vector<int> shapeRefs;
+                auto graph = dm_graphbuilders::axialGraph(map.getInternalMap(), shapeRefs);
+                dm_runmethods::runBrandesChoice(perfWriter, graph, 1, shapeRefs, "Choice [Brandes]",
+                                                map.getAttributeTable());
+            }
+        }
         std::cout << "ok\n" << std::flush;
     }
 
@@ -151,4 +190,5 @@ void AxialParser::run(const CommandLineParser &clp, IPerformanceSink &perfWriter
     DO_TIMED("Writing graph",
              dm_runmethods::writeGraph(clp, metaGraph, clp.getOuputFile().c_str(), false))
     std::cout << " ok" << std::endl;
+    dm_runmethods::storeCachedProduct(clp, productKey, perfWriter);
 }
@@ -34,6 +34,7 @@ class AxialParser : public IModeParser {
     bool runAnalysis() const { return m_runAnalysis; }
 
     bool useChoice() const { return m_choice; }
+    bool useBrandesChoice() const { return m_brandesChoice; }
     bool useLocal() const { return m_local; }
     bool calculateRRA() const { return m_rra; }
 
@@ -46,6 +47,7 @@ class AxialParser : public IModeParser {
     bool m_runAnalysis;
     std::vector<double> m_radii;
     bool m_choice;
+    bool m_brandesChoice;
     bool m_local;
     bool m_rra;
     std::string m_attribute;
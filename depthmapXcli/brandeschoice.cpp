@@ -0,0 +1,245 @@
+// SPDX-FileCopyrightText: 2026 depthmapX authors
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "brandeschoice.h"
+
+#include "taskscheduler.h"
+
+#include <limits>
+#include <mutex>
+
+namespace {
+    constexpr double INF = std::numeric_limits<double>::infinity();
+    constexpr size_t NONE = std::numeric_limits<size_t>::max();
+} // namespace
+
+namespace depthmapX {
+
+    DependencySearch::DependencySearch(const CsrGraph &graph, size_t nodesPerElement)
+        : m_graph(graph), m_nodesPerElement(nodesPerElement), m_dist(graph.numNodes(), INF),
+          m_sigma(graph.numNodes()), m_delta(graph.numNodes()), m_terminal(graph.numNodes()),
+          m_inDegree(graph.numNodes()), m_isSource(graph.numNodes()),
+          m_rank(graph.numNodes(), NONE) {}
+
+    template <bool weighted> bool DependencySearch::isTight(size_t from, size_t edge) const {
+        size_t to = m_graph.targets[edge];
+        double weight = 1.0;
+        if constexpr (weighted) {
+            weight = static_cast<double>(m_graph.weights[edge]);
+            // leaving out the edges back into cycles of no weight
+            if (m_rank[to] < m_rank[from]) {
+                return false;
+            }
+        }
+        return !m_isSource[to] && m_dist[from] + weight == m_dist[to];
+    }
+
+    void DependencySearch::run(size_t origin, std::vector<double> &dependencies) {
+        if (m_graph.isWeighted()) {
+            runSearch<true>(origin, dependencies);
+        } else {
+            runSearch<false>(origin, dependencies);
+        }
+    }
+
+    template <bool weighted>
+    void DependencySearch::runSearch(size_t origin, std::vector<double> &dependencies) {
+        for (size_t node : m_reached) {
+            m_dist[node] = INF;
+            m_sigma[node] = 0;
+            m_delta[node] = 0;
+            m_terminal[node] = 0;
+            m_inDegree[node] = 0;
+            m_isSource[node] = 0;
+            m_rank[node] = NONE;
+        }
+        m_reached.clear();
+        m_order.clear();
+        m_queue.clear();
+
+        if constexpr (weighted) {
+            countWeightedPaths(origin);
+        } else {
+            // breadth first, as every edge counts 1 the order the nodes are
+            // reached in already follows the edges on shortest paths
+            for (size_t j = 0; j < m_nodesPerElement; j++) {
+                size_t source = origin * m_nodesPerElement + j;
+                m_dist[source] = 0;
+                m_isSource[source] = 1;
+                m_sigma[source] = 1;
+                m_order.push_back(source);
+            }
+            for (size_t i = 0; i < m_order.size(); i++) {
+                size_t node = m_order[i];
+                for (size_t e = m_graph.offsets[node]; e < m_graph.offsets[node + 1]; e++) {
+                    size_t next = m_graph.targets[e];
+                    if (m_dist[next] == INF) {
+                        m_dist[next] = m_dist[node] + 1;
+                        m_order.push_back(next);
+                    }
+                    if (m_dist[next] == m_dist[node] + 1) {
+                        m_sigma[next] += m_sigma[node];
+                    }
+                }
+            }
+            m_reached = m_order;
+        }
+
+        // the paths to an element end at whichever of its nodes are nearest,
+        // shared between them by their counts
+        for (size_t node : m_reached) {
+            size_t first = node - node % m_nodesPerElement;
+            if (first == origin * m_nodesPerElement) {
+                continue;
+            }
+            double nearest = INF;
+            double numPaths = 0;
+            for (size_t j = first; j < first + m_nodesPerElement; j++) {
+                if (m_dist[j] < nearest) {
+                    nearest = m_dist[j];
+                    numPaths = 0;
+                }
+                if (m_dist[j] == nearest) {
+                    numPaths += m_sigma[j];
+                }
+            }
+            if (m_dist[node] == nearest) {
+                m_terminal[node] = m_sigma[node] / numPaths;
+            }
+        }
+
+        // and the dependencies back from the furthest nodes
+        for (size_t i = m_order.size(); i-- > 0;) {
+            size_t node = m_order[i];
+            double share = 0;
+            for (size_t e = m_graph.offsets[node]; e < m_graph.offsets[node + 1]; e++) {
+                if (isTight<weighted>(node, e)) {
+                    size_t next = m_graph.targets[e];
+                    share += (m_terminal[next] + m_delta[next]) / m_sigma[next];
+                }
+            }
+            m_delta[node] = m_sigma[node] * share;
+        }
+
+        dependencies.assign(m_graph.numNodes() / m_nodesPerElement, 0);
+        for (size_t node : m_order) {
+            dependencies[node / m_nodesPerElement] += m_delta[node];
+        }
+        dependencies[origin] = 0;
+    }
+
+    void DependencySearch::countWeightedPaths(size_t origin) {
+        // distances, reaching the nodes in order of distance
+        for (size_t j = 0; j < m_nodesPerElement; j++) {
+            size_t source = origin * m_nodesPerElement + j;
+            m_dist[source] = 0;
+            m_isSource[source] = 1;
+            m_queue.push(0, source);
+        }
+        while (!m_queue.empty()) {
+            auto [distance, node] = m_queue.pop();
+            // a node is only pushed again at a shorter distance
+            if (distance > m_dist[node]) {
+                continue;
+            }
+            m_reached.push_back(node);
+            for (size_t e = m_graph.offsets[node]; e < m_graph.offsets[node + 1]; e++) {
+                size_t next = m_graph.targets[e];
+                double weight = static_cast<double>(m_graph.weights[e]);
+                if (distance + weight < m_dist[next]) {
+                    m_dist[next] = distance + weight;
+                    m_queue.push(distance + weight, next);
+                }
+            }
+        }
+
+        // An order of the nodes along the edges on shortest paths. Those
+        // edges only join nodes at the same distance if they are of no
+        // weight, so each run of nodes at one distance is ordered along its
+        // edges of no weight. Where these form a cycle, the node of the cycle
+        // reached first goes first and the edges back into it are left out,
+        // so paths go round a cycle of no weight once from where they enter it
+        for (size_t begin = 0, end = 0; begin < m_reached.size(); begin = end) {
+            double distance = m_dist[m_reached[begin]];
+            while (end < m_reached.size() && m_dist[m_reached[end]] == distance) {
+                end++;
+            }
+            for (size_t i = begin; i < end; i++) {
+                size_t node = m_reached[i];
+                for (size_t e = m_graph.offsets[node]; e < m_graph.offsets[node + 1]; e++) {
+                    size_t next = m_graph.targets[e];
+                    if (!m_isSource[next] && m_dist[next] == distance) {
+                        m_inDegree[next]++;
+                    }
+                }
+            }
+            size_t levelStart = m_order.size();
+            for (size_t i = begin; i < end; i++) {
+                if (m_inDegree[m_reached[i]] == 0) {
+                    m_rank[m_reached[i]] = m_order.size();
+                    m_order.push_back(m_reached[i]);
+                }
+            }
+            size_t firstUnordered = begin;
+            for (size_t numOrdered = 0; numOrdered < end - begin;) {
+                if (m_order.size() == levelStart + numOrdered) {
+                    // nothing left without edges into it, break a cycle
+                    while (m_rank[m_reached[firstUnordered]] != NONE) {
+                        firstUnordered++;
+                    }
+                    size_t node = m_reached[firstUnordered];
+                    m_rank[node] = m_order.size();
+                    m_order.push_back(node);
+                }
+                size_t node = m_order[levelStart + numOrdered];
+                numOrdered++;
+                for (size_t e = m_graph.offsets[node]; e < m_graph.offsets[node + 1]; e++) {
+                    size_t next = m_graph.targets[e];
+                    if (!m_isSource[next] && m_dist[next] == distance && m_rank[next] == NONE &&
+                        --m_inDegree[next] == 0) {
+                        m_rank[next] = m_order.size();
+                        m_order.push_back(next);
+                    }
+                }
+            }
+        }
+
+        // and the shortest path counts along it
+        for (size_t j = 0; j < m_nodesPerElement; j++) {
+            m_sigma[origin * m_nodesPerElement + j] = 1;
+        }
+        for (size_t node : m_order) {
+            for (size_t e = m_graph.offsets[node]; e < m_graph.offsets[node + 1]; e++) {
+                if (isTight<true>(node, e)) {
+                    m_sigma[m_graph.targets[e]] += m_sigma[node];
+                }
+            }
+        }
+    }
+
+    std::vector<double> brandesChoice(const CsrGraph &graph, size_t nodesPerElement) {
+        size_t numElements = graph.numNodes() / nodesPerElement;
+        std::vector<double> choice(numElements);
+        std::mutex choiceMutex;
+        auto &scheduler = TaskScheduler::global();
+        size_t grainSize = numElements / (4 * scheduler.numThreads()) + 1;
+        scheduler.parallelFor(0, numElements, grainSize, [&](size_t begin, size_t end) {
+            DependencySearch search(graph, nodesPerElement);
+            std::vector<double> rangeChoice(numElements);
+            std::vector<double> dependencies;
+            for (size_t origin = begin; origin < end; origin++) {
+                search.run(origin, dependencies);
+                for (size_t i = 0; i < numElements; i++) {
+                    rangeChoice[i] += dependencies[i];
+                }
+            }
+            std::lock_guard<std::mutex> lock(choiceMutex);
+            for (size_t i = 0; i < numElements; i++) {
+                choice[i] += rangeChoice[i];
+            }
+        });
+        return choice;
+    }
+
+} // namespace depthmapX
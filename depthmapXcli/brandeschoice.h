@@ -0,0 +1,64 @@
+// SPDX-FileCopyrightText: 2026 depthmapX authors
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#pragma once
+
+// Choice (betweenness) by Brandes' accumulation: one search per origin counts
+// the shortest paths to every node, and a single sweep back from the furthest
+// nodes adds up how many of them pass through each, so that choice costs about
+// as much as the depths do instead of a walk back along every path. Elements
+// are runs of consecutive nodes of the graph (one node per axial line, two
+// per segment for its two directions), the paths to an element ending at
+// whichever of its nodes are nearest. Paths of the same length share the
+// pair between them, so weights that are meant to tie (such as tulip bins)
+// should be whole numbers to tie exactly
+
+#include "csrgraph.h"
+#include "radixheap.h"
+
+#include <vector>
+
+namespace depthmapX {
+
+    // Shortest path counts and Brandes' dependency accumulation from one
+    // origin element. An instance keeps its scratch space between origins, so
+    // there should be one instance per thread
+    class DependencySearch {
+      public:
+        DependencySearch(const CsrGraph &graph, size_t nodesPerElement);
+
+        // The share of the shortest paths from the origin to every other
+        // element that passes through each element, leaving out the ends of
+        // the paths
+        void run(size_t origin, std::vector<double> &dependencies);
+
+      private:
+        // specialised on whether the graph is weighted, picked once per
+        // origin so that the inner loops do not check it per edge
+        template <bool weighted> void runSearch(size_t origin, std::vector<double> &dependencies);
+        template <bool weighted> bool isTight(size_t from, size_t edge) const;
+        // Dijkstra, then the path counts in an order of the edges on
+        // shortest paths, which breaks any cycles of edges of no weight
+        void countWeightedPaths(size_t origin);
+
+        const CsrGraph &m_graph;
+        size_t m_nodesPerElement;
+        std::vector<double> m_dist;
+        std::vector<double> m_sigma;
+        std::vector<double> m_delta;
+        std::vector<double> m_terminal;
+        std::vector<size_t> m_inDegree;
+        std::vector<char> m_isSource;
+        // position in m_order, only kept for weighted graphs
+        std::vector<size_t> m_rank;
+        std::vector<size_t> m_reached;
+        std::vector<size_t> m_order;
+        RadixHeap m_queue;
+    };
+
+    // The choice of every element over the paths between all ordered pairs
+    // of elements, spreading the origins over the global task scheduler
+    std::vector<double> brandesChoice(const CsrGraph &graph, size_t nodesPerElement);
+
+} // namespace depthmapX
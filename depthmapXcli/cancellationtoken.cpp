@@ -0,0 +1,37 @@
+// SPDX-FileCopyrightText: 2026 depthmapX authors
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "cancellationtoken.h"
+
+namespace depthmapX {
+
+    bool CancellationToken::isCancelled() const {
+        if (m_cancelled) {
+            return true;
+        }
+        Clock::rep deadline = m_deadline;
+        return deadline != Clock::duration::max().count() &&
+               Clock::now().time_since_epoch().count() >= deadline;
+    }
+
+    void CancellationToken::setDeadline(Clock::time_point deadline) {
+        m_deadline = deadline.time_since_epoch().count();
+    }
+
+    void CancellationToken::setTimeBudget(double seconds) {
+        setDeadline(Clock::now() +
+                    std::chrono::duration_cast<Clock::duration>(
+                        std::chrono::duration<double>(seconds)));
+    }
+
+    bool CancellationToken::hasDeadline() const {
+        return m_deadline != Clock::duration::max().count();
+    }
+
+    CancellationToken &CancellationToken::global() {
+        static CancellationToken token;
+        return token;
+    }
+
+} // namespace depthmapX
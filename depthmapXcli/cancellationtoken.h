@@ -0,0 +1,37 @@
+// SPDX-FileCopyrightText: 2026 depthmapX authors
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#pragma once
+
+// Cooperative cancellation of long analyses. Analyses check the token between
+// records and stop cleanly when it is cancelled, either explicitly or by its
+// deadline passing, keeping what they have calculated so far
+
+#include <atomic>
+#include <chrono>
+
+namespace depthmapX {
+
+    class CancellationToken {
+      public:
+        typedef std::chrono::steady_clock Clock;
+
+        void cancel() { m_cancelled = true; }
+        // cancelled, or past the deadline if there is one
+        bool isCancelled() const;
+
+        void setDeadline(Clock::time_point deadline);
+        // cancels the token the given number of seconds from now
+        void setTimeBudget(double seconds);
+        bool hasDeadline() const;
+
+        // the token of the current run, which the -tb option sets a deadline on
+        static CancellationToken &global();
+
+      private:
+        std::atomic<bool> m_cancelled{false};
+        std::atomic<Clock::rep> m_deadline{Clock::duration::max().count()};
+    };
+
+} // namespace depthmapX
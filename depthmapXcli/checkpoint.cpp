@@ -0,0 +1,119 @@
+// SPDX-FileCopyrightText: 2026 depthmapX authors
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "checkpoint.h"
+
+#include "salalib/genlib/exceptions.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+
+namespace {
+    const char *const CHECKPOINT_HEADER = "depthmapX checkpoint 1";
+
+    uint64_t hashKey(const std::string &key) {
+        // FNV-1a
+        uint64_t hash = 14695981039346656037ull;
+        for (char c : key) {
+            hash ^= static_cast<unsigned char>(c);
+            hash *= 1099511628211ull;
+        }
+        return hash;
+    }
+} // namespace
+
+namespace depthmapX {
+
+    Checkpoint::Checkpoint(const std::string &key, size_t numRecords)
+        : m_key(hashKey(key)), m_results(numRecords), m_finished(numRecords, 0) {}
+
+    size_t Checkpoint::numFinished() const {
+        return static_cast<size_t>(std::count(m_finished.begin(), m_finished.end(), 1));
+    }
+
+    void Checkpoint::finish(size_t record, std::string result) {
+        if (result.find('\n') != std::string::npos) {
+            throw RuntimeException("Checkpoint results must fit on one line");
+        }
+        m_results[record] = std::move(result);
+        m_finished[record] = 1;
+    }
+
+    void Checkpoint::write(const std::string &filename) const {
+        std::string tempFile = filename + ".tmp";
+        {
+            std::ofstream stream(tempFile);
+            stream << CHECKPOINT_HEADER << "\n"
+                   << "key " << std::hex << m_key << std::dec << "\n"
+                   << "records " << m_results.size() << "\n";
+            for (size_t i = 0; i < m_results.size(); i++) {
+                if (m_finished[i]) {
+                    stream << i << " " << m_results[i] << "\n";
+                }
+            }
+            stream << "end\n" << std::flush;
+            if (!stream) {
+                throw RuntimeException("Failed to write checkpoint to " + tempFile);
+            }
+        }
+        if (std::rename(tempFile.c_str(), filename.c_str()) != 0) {
+            // rename does not replace an existing file everywhere
+            std::remove(filename.c_str());
+            if (std::rename(tempFile.c_str(), filename.c_str()) != 0) {
+                throw RuntimeException("Failed to move checkpoint to " + filename);
+            }
+        }
+    }
+
+    void Checkpoint::resume(const std::string &filename) {
+        std::ifstream stream(filename);
+        if (!stream) {
+            throw RuntimeException("Failed to open checkpoint " + filename);
+        }
+        std::string line;
+        std::getline(stream, line);
+        if (line != CHECKPOINT_HEADER) {
+            throw RuntimeException(filename + " is not a checkpoint");
+        }
+
+        std::stringstream expected;
+        expected << "key " << std::hex << m_key;
+        std::getline(stream, line);
+        std::string keyLine = line;
+        std::getline(stream, line);
+        if (keyLine != expected.str() || line != "records " + std::to_string(m_results.size())) {
+            throw RuntimeException("Checkpoint " + filename +
+                                   " was written by a different analysis or input");
+        }
+
+        std::vector<std::string> results(m_results.size());
+        std::vector<char> finished(m_results.size(), 0);
+        bool complete = false;
+        while (std::getline(stream, line)) {
+            if (line == "end") {
+                complete = true;
+                break;
+            }
+            size_t space = line.find(' ');
+            size_t record = m_results.size();
+            if (space != std::string::npos && space > 0 && space < 19 &&
+                line.find_first_not_of("0123456789") == space) {
+                record = std::stoul(line.substr(0, space));
+            }
+            if (record >= m_results.size()) {
+                throw RuntimeException("Invalid record in checkpoint " + filename + ": " + line);
+            }
+            results[record] = line.substr(space + 1);
+            finished[record] = 1;
+        }
+        if (!complete) {
+            throw RuntimeException("Checkpoint " + filename + " is incomplete");
+        }
+        m_results = std::move(results);
+        m_finished = std::move(finished);
+    }
+
+} // namespace depthmapX
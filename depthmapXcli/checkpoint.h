@@ -0,0 +1,45 @@
+// SPDX-FileCopyrightText: 2026 depthmapX authors
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#pragma once
+
+// Results of an analysis that goes through its records one at a time, kept as
+// text so that the analysis can be written out part of the way through and
+// resumed later, giving the same output as a run straight through
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace depthmapX {
+
+    class Checkpoint {
+      public:
+        // The key describes everything the results depend on (options,
+        // graph, records), so that a checkpoint is only resumed by the same
+        // analysis it was written by
+        Checkpoint(const std::string &key, size_t numRecords);
+
+        size_t numRecords() const { return m_results.size(); }
+        size_t numFinished() const;
+        bool isFinished(size_t record) const { return m_finished[record] != 0; }
+        const std::string &result(size_t record) const { return m_results[record]; }
+        // may be called for different records from different threads. The
+        // result must fit on one line
+        void finish(size_t record, std::string result);
+
+        // written next to the file and moved over it, so that a crash while
+        // writing leaves the previous checkpoint in place
+        void write(const std::string &filename) const;
+        // takes over the finished records of the file. Throws a
+        // RuntimeException if it can not be read or belongs to another run
+        void resume(const std::string &filename);
+
+      private:
+        uint64_t m_key;
+        std::vector<std::string> m_results;
+        std::vector<char> m_finished;
+    };
+
+} // namespace depthmapX
@@ -7,24 +7,88 @@
 #include "exceptions.h"
 #include "imodeparserfactory.h"
 #include "interfaceversion.h"
+#include "cancellationtoken.h"
 #include "parsingutils.h"
+#include "taskscheduler.h"
 
 #include <algorithm>
+#include <cstdint>
+#include <cstdlib>
 #include <cstring>
 #include <iostream>
+#include <iterator>
+#include <limits>
+#include <thread>
 
 using namespace depthmapX;
 
+namespace {
+    // the value of an option that takes a whole number, if it is given in
+    // digits and is at most the maximum
+    std::optional<size_t> parseWholeNumber(const std::string &value, size_t maximum) {
+        // longer numbers are beyond the maxima of the options, and beyond
+        // what std::stoull can convert
+        if (value.empty() || value.size() > 12 || !has_only_digits(value)) {
+            return std::nullopt;
+        }
+        unsigned long long number = std::stoull(value);
+        if (number > maximum) {
+            return std::nullopt;
+        }
+        return static_cast<size_t>(number);
+    }
+
+    // time budgets and checkpoint intervals, far below the time a steady
+    // clock can count ahead
+    constexpr size_t MAX_SECONDS = 1000000000;
+} // namespace
+
 void CommandLineParser::printHelp() {
     std::cout << "Usage: depthmapXcli -m <mode> -f <filename> -o <output file> [-s] [-t "
-                 "<times.csv>] [-p] [mode options]\n"
+                 "<times.csv>] [-p] [-pj <progress.json>] [-j <threads>] [-tb <seconds>]\n"
+                 "       [-ck <seconds>] [-rs <checkpoint>] [-or <start>:<end>] [-cd <directory>]\n"
+                 "       [-roi <polygon file>] [-sa <fraction> [-sas <seed>]] [-ml <MiB>]\n"
+                 "       [mode options]\n"
               << "       depthmapXcli -v prints the current version\n"
               << "       depthmapXcli -h prints this help text\n"
+              << "       depthmapXcli -sv <socket> [-svc <graphs>] serves requests on a unix\n"
+              << "          domain socket, keeping up to -svc graphs (default 4) loaded. A\n"
+              << "          request is one line of the arguments of a run separated by tabs,\n"
+              << "          answered with the output of the run and a last line of\n"
+              << "          \"OK <output file>\" or \"ERROR <message>\". Clients that have not\n"
+              << "          sent their request within 10 seconds are disconnected\n"
               << "-s enables simple mode\n"
               << "-t <times.csv> enables output of runtimes as csv file\n"
               << "-p enables text progress printing\n"
+              << "-pj <progress.json> keeps the progress of the analysis in the given file\n"
               << "-idd ignore display data in metagraph files\n"
               << "-mmv mimic a previous version's quirks\n"
+              << "-j <threads> number of threads to run the analysis on, defaults to one per\n"
+              << "   hardware thread and at most 16 per hardware thread\n"
+              << "-tb <seconds> time budget of the analysis. Once it runs out the analysis stops\n"
+              << "   and the results calculated so far are written out\n"
+              << "-ck <seconds> writes a checkpoint next to the output file at most every given\n"
+              << "   number of seconds, and when the time budget runs out\n"
+              << "-rs <checkpoint> resumes the analysis from the given checkpoint\n"
+              << "   Checkpoints are supported by SEGMENTSHORTESTPATH OD matrices\n"
+              << "-or <start>:<end> only analyses the origins from start up to but not including\n"
+              << "   end, counting from 0, to split an analysis into shards that MERGE combines.\n"
+              << "   Supported by STEPDEPTH with -sdm and SEGMENTSHORTESTPATH OD matrices\n"
+              << "-roi <polygon file> only analyses the origins inside the polygon, given as a\n"
+              << "   tab separated file with columns x and y, while paths may still leave it.\n"
+              << "   Supported by STEPDEPTH with -sdm and SEGMENTSHORTESTPATH OD matrices\n"
+              << "-sa <fraction> estimates the global measures from searches run from the given\n"
+              << "   fraction (0 to 1) of the origins only, sampled evenly over the map, into\n"
+              << "   columns marked [Sampled] with the half widths of their 95% confidence\n"
+              << "   intervals. Supported by VGA visibility, AXIAL and SEGMENT tulip analysis\n"
+              << "   at radius n\n"
+              << "-sas <seed> seed of the sample, to repeat it (default 0)\n"
+              << "-ml <MiB> memory the analysis may use for the graph it builds from the map\n"
+              << "   and its scratch space. The scratch space only speeds it up and is cut\n"
+              << "   to what the graph leaves. Supported by VGA with -vlb\n"
+              << "-cd <directory> keeps the outputs of VISPREP, AXIAL and MAPCONVERT in the given\n"
+              << "   directory, and copies them from there when run again with the same input\n"
+              << "   file, options and contents of the files they name (-pf, -roi)\n"
 
               << "Possible modes are:\n";
     std::for_each(m_parserFactory.getModeParsers().begin(), m_parserFactory.getModeParsers().end(),
@@ -41,7 +105,8 @@ void CommandLineParser::printHelp() {
 void CommandLineParser::printVersion() { std::cout << TITLE_BASE << "\n" << std::flush; }
 
 CommandLineParser::CommandLineParser(const IModeParserFactory &parserFactory)
-    : m_simpleMode(false), m_parserFactory(parserFactory), m_modeParser(nullptr) {}
+    : m_simpleMode(false), m_printProgress(false), m_parserFactory(parserFactory),
+      m_modeParser(nullptr) {}
 
 void CommandLineParser::parse(size_t argc, char *argv[]) {
     m_valid = false;
@@ -86,8 +151,98 @@ void CommandLineParser::parse(size_t argc, char *argv[]) {
             m_simpleMode = true;
         } else if (std::strcmp("-p", argv[i]) == 0) {
             m_printProgress = true;
+        } else if (std::strcmp("-pj", argv[i]) == 0) {
+            ENFORCE_ARGUMENT("-pj", i)
+            m_progressFile = argv[i];
         } else if (std::strcmp("-idd", argv[i]) == 0) {
             m_ignoreDisplayData = true;
+        } else if (std::strcmp("-j", argv[i]) == 0) {
+            ENFORCE_ARGUMENT("-j", i)
+            auto numThreads = parseWholeNumber(argv[i], std::numeric_limits<size_t>::max());
+            if (!numThreads || *numThreads == 0) {
+                throw CommandLineException(std::string("-j must be a positive integer, got ") +
+                                           argv[i]);
+            }
+            // well past any use of more threads than the hardware runs
+            size_t maxThreads = 16 * std::max(std::thread::hardware_concurrency(), 1u);
+            if (*numThreads > maxThreads) {
+                throw CommandLineException("-j must be at most " + std::to_string(maxThreads) +
+                                           " threads, got " + argv[i]);
+            }
+            m_numThreads = *numThreads;
+        } else if (std::strcmp("-tb", argv[i]) == 0) {
+            ENFORCE_ARGUMENT("-tb", i)
+            auto timeBudget = parseWholeNumber(argv[i], MAX_SECONDS);
+            if (!timeBudget || *timeBudget == 0) {
+                throw CommandLineException(
+                    std::string("-tb must be a positive number of seconds, got ") + argv[i]);
+            }
+            m_timeBudget = *timeBudget;
+        } else if (std::strcmp("-ck", argv[i]) == 0) {
+            ENFORCE_ARGUMENT("-ck", i)
+            auto checkpointInterval = parseWholeNumber(argv[i], MAX_SECONDS);
+            if (!checkpointInterval || *checkpointInterval == 0) {
+                throw CommandLineException(
+                    std::string("-ck must be a positive number of seconds, got ") + argv[i]);
+            }
+            m_checkpointInterval = *checkpointInterval;
+        } else if (std::strcmp("-rs", argv[i]) == 0) {
+            ENFORCE_ARGUMENT("-rs", i)
+            m_resumeFile = argv[i];
+        } else if (std::strcmp("-sv", argv[i]) == 0) {
+            ENFORCE_ARGUMENT("-sv", i)
+            m_serveSocket = argv[i];
+        } else if (std::strcmp("-svc", argv[i]) == 0) {
+            ENFORCE_ARGUMENT("-svc", i)
+            auto serveCacheSize = parseWholeNumber(argv[i], std::numeric_limits<size_t>::max());
+            if (!serveCacheSize || *serveCacheSize == 0) {
+                throw CommandLineException(
+                    std::string("-svc must be a positive number of graphs, got ") + argv[i]);
+            }
+            m_serveCacheSize = *serveCacheSize;
+        } else if (std::strcmp("-roi", argv[i]) == 0) {
+            ENFORCE_ARGUMENT("-roi", i)
+            m_regionOfInterestFile = argv[i];
+        } else if (std::strcmp("-sa", argv[i]) == 0) {
+            ENFORCE_ARGUMENT("-sa", i)
+            if (!has_only_digits_dots(argv[i]) || std::atof(argv[i]) <= 0 ||
+                std::atof(argv[i]) > 1) {
+                throw CommandLineException(
+                    std::string("-sa must be a fraction above 0 and up to 1, got ") + argv[i]);
+            }
+            m_sampleFraction = std::atof(argv[i]);
+        } else if (std::strcmp("-sas", argv[i]) == 0) {
+            ENFORCE_ARGUMENT("-sas", i)
+            auto sampleSeed = parseWholeNumber(argv[i], std::numeric_limits<uint32_t>::max());
+            if (!sampleSeed) {
+                throw CommandLineException(
+                    std::string("-sas must be a non-negative 32 bit integer, got ") + argv[i]);
+            }
+            m_sampleSeed = static_cast<uint32_t>(*sampleSeed);
+        } else if (std::strcmp("-ml", argv[i]) == 0) {
+            ENFORCE_ARGUMENT("-ml", i)
+            auto memoryLimit = parseWholeNumber(argv[i], std::numeric_limits<size_t>::max() >> 20);
+            if (!memoryLimit || *memoryLimit == 0) {
+                throw CommandLineException(
+                    std::string("-ml must be a positive number of MiB, got ") + argv[i]);
+            }
+            m_memoryLimit = *memoryLimit << 20;
+        } else if (std::strcmp("-cd", argv[i]) == 0) {
+            ENFORCE_ARGUMENT("-cd", i)
+            m_cacheDirectory = argv[i];
+        } else if (std::strcmp("-or", argv[i]) == 0) {
+            ENFORCE_ARGUMENT("-or", i)
+            std::string range = argv[i];
+            size_t colon = range.find(':');
+            std::string start = range.substr(0, colon);
+            std::string end = colon == std::string::npos ? "" : range.substr(colon + 1);
+            auto first = parseWholeNumber(start, std::numeric_limits<size_t>::max());
+            auto last = parseWholeNumber(end, std::numeric_limits<size_t>::max());
+            if (!first || !last || *first >= *last) {
+                throw CommandLineException(
+                    "-or must be given as <start>:<end> with start below end, got " + range);
+            }
+            m_originRange = std::make_pair(*first, *last);
         } else if (std::strcmp("-mmv", argv[i]) == 0) {
             ENFORCE_ARGUMENT("-t", i)
             m_mimicVersion = argv[i];
@@ -95,10 +250,30 @@ void CommandLineParser::parse(size_t argc, char *argv[]) {
         ++i;
     }
 
+    m_productOptions.clear();
+    for (size_t i = 1; i < argc; i++) {
+        static const char *const runOptionsWithValue[] = {"-f",  "-o",  "-t",   "-pj",
+                                                          "-j",  "-tb", "-ck",  "-rs",
+                                                          "-cd", "-sv", "-svc", "-ml"};
+        if (std::strcmp("-p", argv[i]) == 0) {
+            continue;
+        }
+        if (std::any_of(std::begin(runOptionsWithValue), std::end(runOptionsWithValue),
+                        [&](const char *option) { return std::strcmp(option, argv[i]) == 0; })) {
+            i++;
+            continue;
+        }
+        m_productOptions.push_back(argv[i]);
+    }
+
+    if (!m_serveSocket.empty()) {
+        // the requests give the mode and files
+        return;
+    }
     if (!m_modeParser) {
         throw CommandLineException("-m for mode is required");
     }
-    if (m_fileName.empty()) {
+    if (m_fileName.empty() && m_modeParser->needsInputFile()) {
         throw CommandLineException("-f for input file is required");
     }
     if (m_outputFile.empty()) {
@@ -112,5 +287,11 @@ void CommandLineParser::run(IPerformanceSink &perfWriter) const {
     if (!m_valid || !m_modeParser) {
         throw CommandLineException("Trying to run with invalid command line parameters");
     }
+    if (m_numThreads > 0) {
+        TaskScheduler::setGlobalThreads(m_numThreads);
+    }
+    if (m_timeBudget > 0) {
+        CancellationToken::global().setTimeBudget(static_cast<double>(m_timeBudget));
+    }
     m_modeParser->run(*this, perfWriter);
 }
@@ -4,9 +4,11 @@
 
 #pragma once
 
+#include <cstdint>
 #include <memory>
 #include <optional>
 #include <string>
+#include <utility>
 #include <vector>
 
 class IModeParserFactory;
@@ -25,7 +27,36 @@ class CommandLineParser {
     bool printVersionMode() const { return m_printVersionMode; }
     bool simpleMode() const { return m_simpleMode; }
     bool printProgress() const { return m_printProgress; }
+    const std::string &getProgressFile() const { return m_progressFile; }
     bool ignoreDisplayData() const { return m_ignoreDisplayData; }
+    // 0 if not given, for one thread per hardware thread
+    size_t getNumThreads() const { return m_numThreads; }
+    // in seconds, 0 if the analysis may run for as long as it takes
+    size_t getTimeBudget() const { return m_timeBudget; }
+    // in seconds, 0 if no checkpoints are written
+    size_t getCheckpointInterval() const { return m_checkpointInterval; }
+    const std::string &getResumeFile() const { return m_resumeFile; }
+    // empty unless the server mode is asked for
+    const std::string &getServeSocket() const { return m_serveSocket; }
+    size_t getServeCacheSize() const { return m_serveCacheSize; }
+    // empty unless products are to be cached
+    const std::string &getCacheDirectory() const { return m_cacheDirectory; }
+    // the arguments the output of the run depends on besides the input file,
+    // leaving out files and options that only change how it runs
+    const std::vector<std::string> &getProductOptions() const { return m_productOptions; }
+    // first and one past the last origin to analyse, if only a shard of the
+    // analysis is to be run
+    const std::optional<std::pair<size_t, size_t>> &getOriginRange() const {
+        return m_originRange;
+    }
+    // polygon file limiting the origins analysed, empty for all
+    const std::string &getRegionOfInterestFile() const { return m_regionOfInterestFile; }
+    // fraction of the origins to estimate the measures from, 0 for all
+    double getSampleFraction() const { return m_sampleFraction; }
+    uint32_t getSampleSeed() const { return m_sampleSeed; }
+    // bytes the cli kernels may take for the graph they build and their
+    // optional scratch space, 0 for their defaults
+    size_t getMemoryLimit() const { return m_memoryLimit; }
     const std::optional<std::string> &getMimickVersion() const { return m_mimicVersion; }
     const IModeParser &modeOptions() const { return *m_modeParser; };
 
@@ -37,11 +68,25 @@ class CommandLineParser {
     std::string m_fileName;
     std::string m_outputFile;
     std::string m_timingFile;
+    std::string m_progressFile;
     bool m_valid;
     bool m_printVersionMode;
     bool m_simpleMode;
     bool m_printProgress;
     bool m_ignoreDisplayData = false;
+    size_t m_numThreads = 0;
+    size_t m_timeBudget = 0;
+    size_t m_checkpointInterval = 0;
+    std::string m_resumeFile;
+    std::optional<std::pair<size_t, size_t>> m_originRange = std::nullopt;
+    std::string m_regionOfInterestFile;
+    double m_sampleFraction = 0;
+    uint32_t m_sampleSeed = 0;
+    size_t m_memoryLimit = 0;
+    std::string m_serveSocket;
+    size_t m_serveCacheSize = 4;
+    std::string m_cacheDirectory;
+    std::vector<std::string> m_productOptions;
     std::optional<std::string> m_mimicVersion = std::nullopt;
 
     const IModeParserFactory &m_parserFactory;
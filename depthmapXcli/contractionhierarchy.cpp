@@ -0,0 +1,531 @@
+// SPDX-FileCopyrightText: 2026 depthmapX authors
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "contractionhierarchy.h"
+
+#include "salalib/genlib/exceptions.h"
+
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <queue>
+#include <random>
+#include <sstream>
+
+namespace {
+    using depthmapX::SearchLabels;
+
+    // witness searches give up after settling this many nodes, in which case
+    // the shortcut is added even if it might not be needed. This keeps the
+    // preprocessing fast at the cost of a few redundant edges
+    const size_t WITNESS_SETTLE_LIMIT = 500;
+
+    const char FILE_MAGIC[4] = {'D', 'M', 'C', 'H'};
+    const uint32_t FILE_VERSION = 1;
+
+    struct Arc {
+        size_t node;
+        double weight;
+        size_t middle;
+    };
+
+    struct Shortcut {
+        size_t from;
+        size_t to;
+        double weight;
+    };
+
+    // The graph as it is being contracted. Contracting a node detaches it from
+    // its neighbours, so its own arcs are left connecting it to the more
+    // important nodes only: these are its edges in the hierarchy
+    class Contractor {
+      public:
+        explicit Contractor(const depthmapX::CsrGraph &graph)
+            : out(graph.numNodes()), in(graph.numNodes()), contracted(graph.numNodes(), 0),
+              contractedNeighbours(graph.numNodes(), 0), level(graph.numNodes(), 0) {
+            m_witness.init(graph.numNodes());
+            m_isTarget.assign(graph.numNodes(), 0);
+            for (size_t node = 0; node < graph.numNodes(); node++) {
+                for (size_t e = graph.offsets[node]; e < graph.offsets[node + 1]; e++) {
+                    if (graph.targets[e] != node) {
+                        addArc(node, graph.targets[e],
+                               graph.isWeighted() ? static_cast<double>(graph.weights[e]) : 1.0,
+                               SearchLabels::NONE);
+                    }
+                }
+            }
+        }
+
+        // adds the arc, or lowers the weight of an existing one between the
+        // same nodes if the new one is shorter
+        void addArc(size_t from, size_t to, double weight, size_t middle) {
+            for (Arc &arc : out[from]) {
+                if (arc.node != to) {
+                    continue;
+                }
+                if (arc.weight > weight) {
+                    arc.weight = weight;
+                    arc.middle = middle;
+                    for (Arc &back : in[to]) {
+                        if (back.node == from) {
+                            back.weight = weight;
+                            back.middle = middle;
+                            break;
+                        }
+                    }
+                }
+                return;
+            }
+            out[from].push_back({to, weight, middle});
+            in[to].push_back({from, weight, middle});
+        }
+
+        // the shortcuts needed to keep all shortest paths through the node
+        // once it is contracted
+        void findShortcuts(size_t node, std::vector<Shortcut> &shortcuts) {
+            shortcuts.clear();
+            double maxOut = 0;
+            for (const Arc &outArc : out[node]) {
+                maxOut = std::max(maxOut, outArc.weight);
+            }
+            for (const Arc &inArc : in[node]) {
+                witnessSearch(inArc.node, node, inArc.weight + maxOut);
+                for (const Arc &outArc : out[node]) {
+                    if (outArc.node == inArc.node) {
+                        continue;
+                    }
+                    double through = inArc.weight + outArc.weight;
+                    if (m_witness.dist[outArc.node] > through) {
+                        shortcuts.push_back({inArc.node, outArc.node, through});
+                    }
+                }
+            }
+        }
+
+        // edge difference, plus the number of contracted neighbours and the
+        // level of the node to spread the contraction evenly over the graph
+        int priority(size_t node, const std::vector<Shortcut> &shortcuts) const {
+            int degree = static_cast<int>(out[node].size() + in[node].size());
+            return 2 * (static_cast<int>(shortcuts.size()) - degree) +
+                   contractedNeighbours[node] + level[node];
+        }
+
+        void contract(size_t node, const std::vector<Shortcut> &shortcuts) {
+            for (const Shortcut &shortcut : shortcuts) {
+                addArc(shortcut.from, shortcut.to, shortcut.weight, node);
+            }
+            contracted[node] = 1;
+            for (const Arc &arc : out[node]) {
+                detach(in[arc.node], node);
+            }
+            for (const Arc &arc : in[node]) {
+                detach(out[arc.node], node);
+            }
+            for (const auto *arcs : {&out[node], &in[node]}) {
+                for (const Arc &arc : *arcs) {
+                    contractedNeighbours[arc.node]++;
+                    level[arc.node] = std::max(level[arc.node], level[node] + 1);
+                }
+            }
+        }
+
+        // the uncontracted nodes next to the node
+        void neighbours(size_t node, std::vector<size_t> &nodes) const {
+            nodes.clear();
+            for (const auto *arcs : {&out[node], &in[node]}) {
+                for (const Arc &arc : *arcs) {
+                    nodes.push_back(arc.node);
+                }
+            }
+            std::sort(nodes.begin(), nodes.end());
+            nodes.erase(std::unique(nodes.begin(), nodes.end()), nodes.end());
+        }
+
+        std::vector<std::vector<Arc>> out;
+        std::vector<std::vector<Arc>> in;
+        std::vector<char> contracted;
+        std::vector<int> contractedNeighbours;
+        std::vector<int> level;
+
+      private:
+        static void detach(std::vector<Arc> &arcs, size_t node) {
+            for (size_t i = 0; i < arcs.size(); i++) {
+                if (arcs[i].node == node) {
+                    arcs[i] = arcs.back();
+                    arcs.pop_back();
+                    return;
+                }
+            }
+        }
+
+        // Dijkstra among the uncontracted nodes, avoiding the one about to be
+        // contracted and stopping once all its out-neighbours are settled or
+        // the search goes beyond the longest path through it
+        void witnessSearch(size_t source, size_t avoid, double maxDistance) {
+            size_t numTargets = out[avoid].size();
+            for (const Arc &arc : out[avoid]) {
+                m_isTarget[arc.node] = 1;
+            }
+            m_witness.reset();
+            m_witnessQueue.clear();
+            m_witness.label(source, 0, SearchLabels::NONE);
+            m_witnessQueue.push(0, source);
+            size_t settledCount = 0;
+            while (!m_witnessQueue.empty()) {
+                auto [distance, node] = m_witnessQueue.pop();
+                if (m_witness.settled[node] || distance > m_witness.dist[node]) {
+                    continue;
+                }
+                if (distance > maxDistance || ++settledCount > WITNESS_SETTLE_LIMIT) {
+                    break;
+                }
+                m_witness.settled[node] = 1;
+                if (m_isTarget[node] && --numTargets == 0) {
+                    break;
+                }
+                for (const Arc &arc : out[node]) {
+                    if (arc.node == avoid) {
+                        continue;
+                    }
+                    double nextDistance = distance + arc.weight;
+                    if (nextDistance < m_witness.dist[arc.node]) {
+                        m_witness.label(arc.node, nextDistance, node);
+                        m_witnessQueue.push(nextDistance, arc.node);
+                    }
+                }
+            }
+            for (const Arc &arc : out[avoid]) {
+                m_isTarget[arc.node] = 0;
+            }
+        }
+
+        SearchLabels m_witness;
+        depthmapX::RadixHeap m_witnessQueue;
+        std::vector<char> m_isTarget;
+    };
+
+    template <typename T> void writeVector(std::ostream &stream, const std::vector<T> &values) {
+        uint64_t size = values.size();
+        stream.write(reinterpret_cast<const char *>(&size), sizeof(size));
+        stream.write(reinterpret_cast<const char *>(values.data()),
+                     static_cast<std::streamsize>(values.size() * sizeof(T)));
+    }
+
+    template <typename T>
+    bool readVector(std::istream &stream, std::vector<T> &values, uint64_t maxBytes) {
+        uint64_t size = 0;
+        stream.read(reinterpret_cast<char *>(&size), sizeof(size));
+        if (!stream || size > maxBytes / sizeof(T)) {
+            return false;
+        }
+        values.resize(static_cast<size_t>(size));
+        stream.read(reinterpret_cast<char *>(values.data()),
+                    static_cast<std::streamsize>(values.size() * sizeof(T)));
+        return static_cast<bool>(stream);
+    }
+
+    template <typename EdgesT> bool edgesValid(const EdgesT &edges, size_t numNodes) {
+        if (edges.offsets.size() != numNodes + 1 || edges.offsets.front() != 0 ||
+            edges.offsets.back() != edges.targets.size() ||
+            edges.weights.size() != edges.targets.size() ||
+            edges.middles.size() != edges.targets.size() ||
+            !std::is_sorted(edges.offsets.begin(), edges.offsets.end())) {
+            return false;
+        }
+        for (size_t e = 0; e < edges.targets.size(); e++) {
+            if (edges.targets[e] >= numNodes ||
+                (edges.middles[e] >= numNodes && edges.middles[e] != SearchLabels::NONE)) {
+                return false;
+            }
+        }
+        return true;
+    }
+} // namespace
+
+namespace depthmapX {
+
+    uint64_t graphFingerprint(const CsrGraph &graph) {
+        // FNV-1a
+        uint64_t hash = 14695981039346656037ull;
+        auto mix = [&hash](const void *data, size_t size) {
+            const unsigned char *bytes = static_cast<const unsigned char *>(data);
+            for (size_t i = 0; i < size; i++) {
+                hash ^= bytes[i];
+                hash *= 1099511628211ull;
+            }
+        };
+        mix(graph.offsets.data(), graph.offsets.size() * sizeof(size_t));
+        mix(graph.targets.data(), graph.targets.size() * sizeof(size_t));
+        mix(graph.weights.data(), graph.weights.size() * sizeof(float));
+        return hash;
+    }
+
+    ContractionHierarchy ContractionHierarchy::build(const CsrGraph &graph) {
+        const size_t numNodes = graph.numNodes();
+        Contractor contractor(graph);
+        std::vector<Shortcut> shortcuts;
+
+        typedef std::pair<int, size_t> PriorityEntry;
+        std::priority_queue<PriorityEntry, std::vector<PriorityEntry>,
+                            std::greater<PriorityEntry>>
+            queue;
+        std::vector<int> priorities(numNodes);
+        for (size_t node = 0; node < numNodes; node++) {
+            contractor.findShortcuts(node, shortcuts);
+            priorities[node] = contractor.priority(node, shortcuts);
+            queue.push({priorities[node], node});
+        }
+
+        // the neighbours of a contracted node get their priority updated
+        // straight away, everything else lazily: a node is only contracted if
+        // it is still the least important once its priority is recalculated.
+        // Queue entries with an outdated priority are skipped
+        std::vector<size_t> neighbours;
+        while (!queue.empty()) {
+            auto [queuedPriority, node] = queue.top();
+            queue.pop();
+            if (contractor.contracted[node] || queuedPriority != priorities[node]) {
+                continue;
+            }
+            contractor.findShortcuts(node, shortcuts);
+            priorities[node] = contractor.priority(node, shortcuts);
+            if (!queue.empty() && priorities[node] > queue.top().first) {
+                queue.push({priorities[node], node});
+                continue;
+            }
+            contractor.neighbours(node, neighbours);
+            contractor.contract(node, shortcuts);
+            for (size_t neighbour : neighbours) {
+                contractor.findShortcuts(neighbour, shortcuts);
+                int priority = contractor.priority(neighbour, shortcuts);
+                if (priority != priorities[neighbour]) {
+                    priorities[neighbour] = priority;
+                    queue.push({priority, neighbour});
+                }
+            }
+        }
+
+        ContractionHierarchy hierarchy;
+        hierarchy.m_fingerprint = graphFingerprint(graph);
+        auto flatten = [&hierarchy](const std::vector<std::vector<Arc>> &arcs, Edges &edges) {
+            for (const auto &nodeArcs : arcs) {
+                for (const Arc &arc : nodeArcs) {
+                    edges.targets.push_back(arc.node);
+                    edges.weights.push_back(arc.weight);
+                    edges.middles.push_back(arc.middle);
+                    if (arc.middle != SearchLabels::NONE) {
+                        hierarchy.m_numShortcuts++;
+                    }
+                }
+                edges.offsets.push_back(edges.targets.size());
+            }
+        };
+        flatten(contractor.out, hierarchy.m_up);
+        flatten(contractor.in, hierarchy.m_down);
+        return hierarchy;
+    }
+
+    void ContractionHierarchy::write(std::ostream &stream) const {
+        stream.write(FILE_MAGIC, sizeof(FILE_MAGIC));
+        uint32_t header[2] = {FILE_VERSION, static_cast<uint32_t>(sizeof(size_t))};
+        stream.write(reinterpret_cast<const char *>(header), sizeof(header));
+        uint64_t numShortcuts = m_numShortcuts;
+        stream.write(reinterpret_cast<const char *>(&m_fingerprint), sizeof(m_fingerprint));
+        stream.write(reinterpret_cast<const char *>(&numShortcuts), sizeof(numShortcuts));
+        for (const Edges *edges : {&m_up, &m_down}) {
+            writeVector(stream, edges->offsets);
+            writeVector(stream, edges->targets);
+            writeVector(stream, edges->weights);
+            writeVector(stream, edges->middles);
+        }
+    }
+
+    void ContractionHierarchy::writeFile(const std::string &filename) const {
+        // under a name of its own, as runs on the same graph may write it at
+        // once
+        std::stringstream tempFile;
+        tempFile << filename << "." << std::hex << std::random_device()() << ".tmp";
+        {
+            std::ofstream stream(tempFile.str(), std::ios::binary);
+            write(stream);
+            stream << std::flush;
+            if (!stream) {
+                std::error_code error;
+                std::filesystem::remove(tempFile.str(), error);
+                throw RuntimeException("Failed to write contraction hierarchy to " + filename);
+            }
+        }
+        std::error_code error;
+        std::filesystem::rename(tempFile.str(), filename, error);
+        if (error) {
+            std::filesystem::remove(tempFile.str(), error);
+            throw RuntimeException("Failed to move contraction hierarchy to " + filename);
+        }
+    }
+
+    bool ContractionHierarchy::read(std::istream &stream, const CsrGraph &graph) {
+        *this = ContractionHierarchy();
+
+        // bound what the stream can claim to hold before allocating for it
+        auto start = stream.tellg();
+        stream.seekg(0, std::ios::end);
+        auto end = stream.tellg();
+        stream.seekg(start);
+        if (!stream || end < start) {
+            return false;
+        }
+        uint64_t maxBytes = static_cast<uint64_t>(end - start);
+
+        char magic[sizeof(FILE_MAGIC)];
+        uint32_t header[2];
+        uint64_t fingerprint = 0;
+        uint64_t numShortcuts = 0;
+        stream.read(magic, sizeof(magic));
+        stream.read(reinterpret_cast<char *>(header), sizeof(header));
+        stream.read(reinterpret_cast<char *>(&fingerprint), sizeof(fingerprint));
+        stream.read(reinterpret_cast<char *>(&numShortcuts), sizeof(numShortcuts));
+        if (!stream || !std::equal(magic, magic + sizeof(magic), FILE_MAGIC) ||
+            header[0] != FILE_VERSION || header[1] != sizeof(size_t) ||
+            fingerprint != graphFingerprint(graph)) {
+            return false;
+        }
+
+        ContractionHierarchy hierarchy;
+        hierarchy.m_fingerprint = fingerprint;
+        hierarchy.m_numShortcuts = static_cast<size_t>(numShortcuts);
+        for (Edges *edges : {&hierarchy.m_up, &hierarchy.m_down}) {
+            if (!readVector(stream, edges->offsets, maxBytes) ||
+                !readVector(stream, edges->targets, maxBytes) ||
+                !readVector(stream, edges->weights, maxBytes) ||
+                !readVector(stream, edges->middles, maxBytes) ||
+                !edgesValid(*edges, graph.numNodes())) {
+                return false;
+            }
+        }
+        *this = std::move(hierarchy);
+        return true;
+    }
+
+    ContractionHierarchyQuery::ContractionHierarchyQuery(const ContractionHierarchy &hierarchy)
+        : m_hierarchy(hierarchy) {
+        m_forward.init(hierarchy.numNodes());
+        m_backward.init(hierarchy.numNodes());
+    }
+
+    PathResult ContractionHierarchyQuery::query(const std::vector<size_t> &sources,
+                                                const std::vector<size_t> &targets,
+                                                bool withPath) {
+        const double INF = SearchLabels::INF;
+        const size_t NONE = SearchLabels::NONE;
+        m_forward.reset();
+        m_backward.reset();
+        m_forwardQueue.clear();
+        m_backwardQueue.clear();
+
+        for (size_t source : sources) {
+            m_forward.label(source, 0, NONE);
+            m_forwardQueue.push(0, source);
+        }
+        double best = INF;
+        size_t meeting = NONE;
+        for (size_t target : targets) {
+            m_backward.label(target, 0, NONE);
+            m_backwardQueue.push(0, target);
+            if (m_forward.dist[target] == 0) {
+                best = 0;
+                meeting = target;
+            }
+        }
+
+        // both searches only move upwards in the hierarchy, and each one can
+        // stop as soon as it can not improve on the best meeting found
+        while (true) {
+            bool forwardActive = !m_forwardQueue.empty() && m_forwardQueue.top().first < best;
+            bool backwardActive = !m_backwardQueue.empty() && m_backwardQueue.top().first < best;
+            if (!forwardActive && !backwardActive) {
+                break;
+            }
+            bool forwardStep =
+                forwardActive &&
+                (!backwardActive || m_forwardQueue.top().first <= m_backwardQueue.top().first);
+            RadixHeap &queue = forwardStep ? m_forwardQueue : m_backwardQueue;
+            SearchLabels &side = forwardStep ? m_forward : m_backward;
+            const SearchLabels &other = forwardStep ? m_backward : m_forward;
+            const ContractionHierarchy::Edges &edges =
+                forwardStep ? m_hierarchy.m_up : m_hierarchy.m_down;
+
+            auto [distance, node] = queue.pop();
+            if (side.settled[node] || distance > side.dist[node]) {
+                continue;
+            }
+            side.settled[node] = 1;
+            for (size_t e = edges.offsets[node]; e < edges.offsets[node + 1]; e++) {
+                size_t next = edges.targets[e];
+                double nextDistance = distance + edges.weights[e];
+                if (nextDistance < side.dist[next]) {
+                    side.label(next, nextDistance, node);
+                    queue.push(nextDistance, next);
+                    if (other.dist[next] != INF && nextDistance + other.dist[next] < best) {
+                        best = nextDistance + other.dist[next];
+                        meeting = next;
+                    }
+                }
+            }
+        }
+
+        PathResult result;
+        if (meeting == NONE) {
+            return result;
+        }
+        result.distance = best;
+        if (withPath) {
+            std::vector<size_t> hierarchyPath;
+            for (size_t node = meeting; node != NONE; node = m_forward.parent[node]) {
+                hierarchyPath.push_back(node);
+            }
+            std::reverse(hierarchyPath.begin(), hierarchyPath.end());
+            for (size_t node = m_backward.parent[meeting]; node != NONE;
+                 node = m_backward.parent[node]) {
+                hierarchyPath.push_back(node);
+            }
+            result.nodes.push_back(hierarchyPath.front());
+            for (size_t i = 1; i < hierarchyPath.size(); i++) {
+                unpack(hierarchyPath[i - 1], hierarchyPath[i], result.nodes);
+            }
+        }
+        return result;
+    }
+
+    void ContractionHierarchyQuery::unpack(size_t from, size_t to,
+                                           std::vector<size_t> &nodes) const {
+        const ContractionHierarchy::Edges &up = m_hierarchy.m_up;
+        const ContractionHierarchy::Edges &down = m_hierarchy.m_down;
+        std::vector<std::pair<size_t, size_t>> pending{{from, to}};
+        while (!pending.empty()) {
+            auto [a, b] = pending.back();
+            pending.pop_back();
+            // the edge a -> b is stored at whichever end is less important
+            size_t middle = SearchLabels::NONE;
+            for (size_t e = up.offsets[a]; e < up.offsets[a + 1]; e++) {
+                if (up.targets[e] == b) {
+                    middle = up.middles[e];
+                    break;
+                }
+            }
+            for (size_t e = down.offsets[b]; e < down.offsets[b + 1]; e++) {
+                if (down.targets[e] == a) {
+                    middle = down.middles[e];
+                    break;
+                }
+            }
+            if (middle == SearchLabels::NONE) {
+                nodes.push_back(b);
+            } else {
+                pending.push_back({middle, b});
+                pending.push_back({a, middle});
+            }
+        }
+    }
+
+} // namespace depthmapX
@@ -0,0 +1,85 @@
+// SPDX-FileCopyrightText: 2026 depthmapX authors
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#pragma once
+
+// Contraction hierarchy over a weighted CsrGraph. Building it contracts the
+// nodes one by one in order of importance, adding shortcut edges wherever a
+// shortest path ran through the contracted node, so that afterwards any
+// shortest path can be found by two small searches that only move towards more
+// important nodes. Building is slow, so a hierarchy can be written out and read
+// back for as long as the graph it was built from does not change
+
+#include "csrgraph.h"
+#include "radixheap.h"
+#include "shortestpathsearch.h"
+
+#include <cstdint>
+#include <istream>
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace depthmapX {
+
+    // Hash of the structure and weights of a graph, to tell whether a saved
+    // hierarchy still belongs to it
+    uint64_t graphFingerprint(const CsrGraph &graph);
+
+    class ContractionHierarchy {
+      public:
+        static ContractionHierarchy build(const CsrGraph &graph);
+
+        size_t numNodes() const { return m_up.offsets.size() - 1; }
+        size_t numShortcuts() const { return m_numShortcuts; }
+
+        void write(std::ostream &stream) const;
+        // writes to a file of its own name next to the given one and moves it
+        // into place, so that no run reads a partly written hierarchy
+        void writeFile(const std::string &filename) const;
+        // false if the stream does not hold a hierarchy of this graph, in
+        // which case the hierarchy is left empty
+        bool read(std::istream &stream, const CsrGraph &graph);
+
+      private:
+        friend class ContractionHierarchyQuery;
+
+        // Edges of the hierarchy grouped by their less important end. The
+        // middle of a shortcut is the node it bypasses, NONE for original edges
+        struct Edges {
+            std::vector<size_t> offsets = {0};
+            std::vector<size_t> targets;
+            std::vector<double> weights;
+            std::vector<size_t> middles;
+        };
+
+        // edges from each node towards more important ones
+        Edges m_up;
+        // edges into each node from more important ones, stored reversed
+        Edges m_down;
+        uint64_t m_fingerprint = 0;
+        size_t m_numShortcuts = 0;
+    };
+
+    // Point to point queries on a hierarchy, with the same semantics as
+    // ShortestPathSearch::bidirectional. One instance per thread
+    class ContractionHierarchyQuery {
+      public:
+        explicit ContractionHierarchyQuery(const ContractionHierarchy &hierarchy);
+
+        PathResult query(const std::vector<size_t> &sources, const std::vector<size_t> &targets,
+                         bool withPath);
+
+      private:
+        // appends the original nodes of the hierarchy edge from -> to, without from
+        void unpack(size_t from, size_t to, std::vector<size_t> &nodes) const;
+
+        const ContractionHierarchy &m_hierarchy;
+        SearchLabels m_forward;
+        SearchLabels m_backward;
+        RadixHeap m_forwardQueue;
+        RadixHeap m_backwardQueue;
+    };
+
+} // namespace depthmapX
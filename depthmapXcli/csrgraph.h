@@ -0,0 +1,71 @@
+// SPDX-FileCopyrightText: 2026 depthmapX authors
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#pragma once
+
+// Compressed sparse row adjacency, used by the cli-side graph kernels so that
+// they can walk the connections of a map without touching the map itself
+
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+namespace depthmapX {
+
+    struct CsrGraph {
+        // edges of node i are targets[offsets[i]] to targets[offsets[i + 1] - 1]
+        std::vector<size_t> offsets = {0};
+        std::vector<size_t> targets;
+        // optional, either empty or of the same size as targets
+        std::vector<float> weights;
+
+        size_t numNodes() const { return offsets.size() - 1; }
+        size_t numEdges() const { return targets.size(); }
+        bool isWeighted() const { return !weights.empty(); }
+
+        size_t degree(size_t node) const { return offsets[node + 1] - offsets[node]; }
+
+        // nodes must be added in order
+        void addNode(const std::vector<size_t> &neighbours) {
+            targets.insert(targets.end(), neighbours.begin(), neighbours.end());
+            offsets.push_back(targets.size());
+        }
+
+        void addNode(const std::vector<std::pair<size_t, float>> &neighbours) {
+            for (const auto &neighbour : neighbours) {
+                targets.push_back(neighbour.first);
+                weights.push_back(neighbour.second);
+            }
+            offsets.push_back(targets.size());
+        }
+
+        // the same graph with every edge flipped, weights are carried over
+        CsrGraph reversed() const {
+            CsrGraph reverse;
+            reverse.offsets.assign(numNodes() + 1, 0);
+            for (size_t target : targets) {
+                reverse.offsets[target + 1]++;
+            }
+            for (size_t i = 0; i < numNodes(); i++) {
+                reverse.offsets[i + 1] += reverse.offsets[i];
+            }
+            reverse.targets.resize(numEdges());
+            if (isWeighted()) {
+                reverse.weights.resize(numEdges());
+            }
+            std::vector<size_t> fill(reverse.offsets.begin(), reverse.offsets.end() - 1);
+            for (size_t from = 0; from < numNodes(); from++) {
+                for (size_t e = offsets[from]; e < offsets[from + 1]; e++) {
+                    size_t pos = fill[targets[e]]++;
+                    reverse.targets[pos] = from;
+                    if (isWeighted()) {
+                        reverse.weights[pos] = weights[e];
+                    }
+                }
+            }
+            return reverse;
+        }
+    };
+
+} // namespace depthmapX
@@ -0,0 +1,106 @@
+// SPDX-FileCopyrightText: 2026 depthmapX authors
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "generateparser.h"
+
+#include "exceptions.h"
+#include "mapgenerator.h"
+#include "parsingutils.h"
+#include "runmethods.h"
+#include "simpletimer.h"
+
+#include <cstring>
+#include <iostream>
+
+using namespace depthmapX;
+
+void GenerateParser::parse(size_t argc, char *argv[]) {
+    for (size_t i = 1; i < argc; ++i) {
+        if (std::strcmp("-gt", argv[i]) == 0) {
+            ENFORCE_ARGUMENT("-gt", i)
+            if (std::strcmp(argv[i], "grid") == 0) {
+                m_mapType = MapType::STREET_GRID;
+            } else if (std::strcmp(argv[i], "city") == 0) {
+                m_mapType = MapType::CITY;
+            } else if (std::strcmp(argv[i], "plan") == 0) {
+                m_mapType = MapType::FLOOR_PLAN;
+            } else {
+                throw CommandLineException(std::string("Invalid map type (-gt): ") + argv[i]);
+            }
+        } else if (std::strcmp("-gn", argv[i]) == 0) {
+            ENFORCE_ARGUMENT("-gn", i)
+            if (!has_only_digits(argv[i]) || std::strlen(argv[i]) > 12 ||
+                std::stoull(argv[i]) == 0) {
+                throw CommandLineException(std::string("-gn must be a positive number, got ") +
+                                           argv[i]);
+            }
+            m_numElements = static_cast<size_t>(std::stoull(argv[i]));
+        } else if (std::strcmp("-gs", argv[i]) == 0) {
+            ENFORCE_ARGUMENT("-gs", i)
+            if (!has_only_digits_dots(argv[i]) || std::atof(argv[i]) <= 0) {
+                throw CommandLineException(std::string("-gs must be a positive size, got ") +
+                                           argv[i]);
+            }
+            m_elementSize = std::atof(argv[i]);
+        } else if (std::strcmp("-grs", argv[i]) == 0) {
+            ENFORCE_ARGUMENT("-grs", i)
+            if (!has_only_digits(argv[i]) || std::strlen(argv[i]) > 9) {
+                throw CommandLineException(std::string("-grs must be a number, got ") + argv[i]);
+            }
+            m_seed = static_cast<uint32_t>(std::stoul(argv[i]));
+        }
+    }
+    if (m_mapType == MapType::NONE) {
+        throw CommandLineException("-gt for the type of map to generate is required");
+    }
+    if (m_numElements == 0) {
+        throw CommandLineException("-gn for the size of the map to generate is required");
+    }
+}
+
+double GenerateParser::getElementSize() const {
+    if (m_elementSize > 0) {
+        return m_elementSize;
+    }
+    return m_mapType == MapType::FLOOR_PLAN ? 4 : 100;
+}
+
+void GenerateParser::run(const CommandLineParser &clp, IPerformanceSink &perfWriter) const {
+    std::vector<Line> lines;
+    std::cout << "Generating map..." << std::flush;
+    switch (m_mapType) {
+    case MapType::STREET_GRID: {
+        DO_TIMED("Generating map", lines = generateStreetGrid(m_numElements, getElementSize()))
+        break;
+    }
+    case MapType::CITY: {
+        DO_TIMED("Generating map",
+                 lines = generateCityFabric(m_numElements, getElementSize(), m_seed))
+        break;
+    }
+    case MapType::FLOOR_PLAN: {
+        DO_TIMED("Generating map", lines = generateFloorPlan(m_numElements, getElementSize()))
+        break;
+    }
+    default:
+        throw depthmapX::SetupCheckException("Unsupported map type");
+    }
+    std::cout << " ok, " << lines.size() << " lines\n" << std::flush;
+
+    MetaGraphDX metaGraph("Generated mgraph");
+    std::vector<ShapeMap> maps;
+    maps.emplace_back("Generated lines", ShapeMap::DRAWINGMAP);
+    SimpleTimer drawingTimer;
+    for (const auto &line : lines) {
+        maps.back().makeLineShape(line);
+    }
+    perfWriter.addData("Making drawing", drawingTimer.getTimeInSeconds());
+    metaGraph.addDrawingFile("Generated map", std::move(maps));
+    metaGraph.setState(metaGraph.getState() | MetaGraphDX::LINEDATA);
+
+    std::cout << "Writing out result..." << std::flush;
+    DO_TIMED("Writing graph",
+             dm_runmethods::writeGraph(clp, metaGraph, clp.getOuputFile().c_str(), false))
+    std::cout << " ok" << std::endl;
+}
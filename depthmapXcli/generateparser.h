@@ -0,0 +1,48 @@
+// SPDX-FileCopyrightText: 2026 depthmapX authors
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#pragma once
+
+#include "commandlineparser.h"
+#include "imodeparser.h"
+
+#include <cstdint>
+#include <string>
+
+class GenerateParser : public IModeParser {
+  public:
+    enum class MapType { NONE, STREET_GRID, CITY, FLOOR_PLAN };
+
+    std::string getModeName() const override { return "GENERATE"; }
+
+    std::string getHelp() const override {
+        return "Mode options for GENERATE:\n"
+               "   Creates a graph with a synthetic drawing to benchmark analyses at scale. No\n"
+               "   input file (-f) is needed\n"
+               "-gt <type> type of map to generate, one of:\n"
+               "      grid - a regular street grid, one line per side of a block\n"
+               "      city - an irregular street fabric\n"
+               "      plan - a floor plan of square rooms with doors between them\n"
+               "-gn <number> number of lines (grid and city) or rooms (plan) to generate\n"
+               "-gs <size> size of a block or room in map units, default 100 for streets and\n"
+               "    4 for rooms\n"
+               "-grs <seed> seed of the irregularities of city, default 1\n";
+    }
+
+  public:
+    void parse(size_t argc, char *argv[]) override;
+    void run(const CommandLineParser &clp, IPerformanceSink &perfWriter) const override;
+    bool needsInputFile() const override { return false; }
+
+    MapType getMapType() const { return m_mapType; }
+    size_t getNumElements() const { return m_numElements; }
+    double getElementSize() const;
+    uint32_t getSeed() const { return m_seed; }
+
+  private:
+    MapType m_mapType = MapType::NONE;
+    size_t m_numElements = 0;
+    double m_elementSize = 0;
+    uint32_t m_seed = 1;
+};
@@ -0,0 +1,134 @@
+// SPDX-FileCopyrightText: 2026 depthmapX authors
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "graphbuilders.h"
+
+#include <cmath>
+#include <unordered_map>
+
+namespace dm_graphbuilders {
+    depthmapX::CsrGraph pointMapVisibilityGraph(PointMap &map, std::vector<PixelRef> &nodeRefs,
+                                                bool mergeLinks) {
+        nodeRefs.clear();
+        std::unordered_map<int, size_t> nodeIndices;
+        const auto &table = map.getAttributeTable();
+        for (auto iter = table.begin(); iter != table.end(); ++iter) {
+            nodeIndices[iter->getKey().value] = nodeRefs.size();
+            nodeRefs.push_back(PixelRef(iter->getKey().value));
+        }
+
+        // weighted only if there are merged pixels to join
+        bool weighted = false;
+        for (size_t i = 0; mergeLinks && !weighted && i < nodeRefs.size(); i++) {
+            PixelRef mergePixel = map.getPoint(nodeRefs[i]).getMergePixel();
+            weighted = !mergePixel.empty() && nodeIndices.find(mergePixel) != nodeIndices.end();
+        }
+
+        depthmapX::CsrGraph graph;
+        graph.offsets.reserve(nodeRefs.size() + 1);
+        std::vector<size_t> neighbours;
+        std::vector<std::pair<size_t, float>> weightedNeighbours;
+        PixelRefVector hood;
+        for (const PixelRef &ref : nodeRefs) {
+            neighbours.clear();
+            hood.clear();
+            Point &point = map.getPoint(ref);
+            if (point.hasNode()) {
+                point.getNode().contents(hood);
+            }
+            for (const PixelRef &visible : hood) {
+                auto indexIter = nodeIndices.find(visible);
+                if (indexIter != nodeIndices.end()) {
+                    neighbours.push_back(indexIter->second);
+                }
+            }
+            if (!weighted) {
+                graph.addNode(neighbours);
+                continue;
+            }
+            weightedNeighbours.clear();
+            for (size_t neighbour : neighbours) {
+                weightedNeighbours.push_back({neighbour, 1.0f});
+            }
+            auto mergeIter = nodeIndices.find(point.getMergePixel());
+            if (!point.getMergePixel().empty() && mergeIter != nodeIndices.end()) {
+                weightedNeighbours.push_back({mergeIter->second, 0.0f});
+            }
+            graph.addNode(weightedNeighbours);
+        }
+        return graph;
+    }
+
+    depthmapX::CsrGraph segmentGraph(ShapeGraph &map, SegmentCost cost, std::vector<int> &shapeRefs,
+                                     std::vector<Point2f> *midpoints, int tulipBins) {
+        shapeRefs.clear();
+        std::vector<double> lengths;
+        if (midpoints) {
+            midpoints->clear();
+        }
+        // connections are indexed by the position of the shape in the map
+        for (const auto &shape : map.getAllShapes()) {
+            shapeRefs.push_back(shape.first);
+            lengths.push_back(shape.second.getLine().length());
+            if (midpoints) {
+                midpoints->push_back(shape.second.getLine().midpoint());
+            }
+        }
+
+        const auto &connections = map.getConnections();
+        depthmapX::CsrGraph graph;
+        graph.offsets.reserve(2 * shapeRefs.size() + 1);
+        std::vector<std::pair<size_t, float>> neighbours;
+        for (size_t segment = 0; segment < shapeRefs.size(); segment++) {
+            for (bool forwards : {true, false}) {
+                neighbours.clear();
+                const auto &segconns = forwards ? connections[segment].forwardSegconns
+                                                : connections[segment].backSegconns;
+                for (const auto &segconn : segconns) {
+                    size_t next = static_cast<size_t>(segconn.first.ref);
+                    float weight = 0;
+                    switch (cost) {
+                    case SegmentCost::ANGULAR:
+                        // turn angles run from 0 to 2 for 0 to 180 degrees
+                        weight = tulipBins > 0
+                                     ? std::round(segconn.second * static_cast<float>(tulipBins) /
+                                                  4.0f)
+                                     : segconn.second;
+                        break;
+                    case SegmentCost::METRIC:
+                        weight = static_cast<float>((lengths[segment] + lengths[next]) * 0.5);
+                        break;
+                    case SegmentCost::TOPOLOGICAL:
+                        weight = segconn.second > 0 ? 1.0f : 0.0f;
+                        break;
+                    }
+                    neighbours.push_back({segmentNode(next, segconn.first.dir == 1), weight});
+                }
+                graph.addNode(neighbours);
+            }
+        }
+        return graph;
+    }
+
+    depthmapX::CsrGraph axialGraph(ShapeGraph &map, std::vector<int> &shapeRefs,
+                                   std::vector<Point2f> *midpoints) {
+        shapeRefs.clear();
+        if (midpoints) {
+            midpoints->clear();
+        }
+        for (const auto &shape : map.getAllShapes()) {
+            shapeRefs.push_back(shape.first);
+            if (midpoints) {
+                midpoints->push_back(shape.second.getLine().midpoint());
+            }
+        }
+
+        depthmapX::CsrGraph graph;
+        graph.offsets.reserve(shapeRefs.size() + 1);
+        for (const auto &connector : map.getConnections()) {
+            graph.addNode(connector.connections);
+        }
+        return graph;
+    }
+} // namespace dm_graphbuilders
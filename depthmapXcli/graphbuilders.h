@@ -0,0 +1,53 @@
+// SPDX-FileCopyrightText: 2026 depthmapX authors
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#pragma once
+
+// Extraction of the connectivity of salalib maps into plain adjacency
+// structures that the cli-side kernels can run on
+
+#include "csrgraph.h"
+
+#include "salalib/genlib/p2dpoly.h"
+#include "salalib/pixelref.h"
+#include "salalib/pointmap.h"
+#include "salalib/shapegraph.h"
+
+#include <vector>
+
+namespace dm_graphbuilders {
+    // The visibility graph of a point map. nodeRefs receives the pixel of each
+    // node in the order of the graph. With mergeLinks, merged (linked) pixels
+    // are joined by edges of weight 0 and all others weigh 1, as salalib's
+    // visual depth puts a merged pixel at the depth of the one it is merged
+    // with; the graph stays unweighted if the map has none. Local measures
+    // leave merged pixels out
+    depthmapX::CsrGraph pointMapVisibilityGraph(PointMap &map, std::vector<PixelRef> &nodeRefs,
+                                                bool mergeLinks);
+
+    enum class SegmentCost { ANGULAR, METRIC, TOPOLOGICAL };
+
+    // Segments are travelled in a direction, so each one is split into two
+    // nodes: 2 * i when moving along segment i forwards and 2 * i + 1 when
+    // moving backwards. Angular cost is the turn angle of the connection,
+    // metric cost is half the length of each of the two segments and
+    // topological cost is one for every turn. shapeRefs receives the ref of
+    // each segment, and midpoints (if given) the middle of each segment. With
+    // tulip bins, angular cost is instead the number of bins the turn angle
+    // rounds to, each of 4 / tulipBins, so that turns in the same bin tie
+    // exactly as they do in tulip analysis
+    depthmapX::CsrGraph segmentGraph(ShapeGraph &map, SegmentCost cost, std::vector<int> &shapeRefs,
+                                     std::vector<Point2f> *midpoints = nullptr,
+                                     int tulipBins = 0);
+
+    // The connections of an axial map, one node per line. shapeRefs receives
+    // the ref of each line, and midpoints (if given) the middle of each line
+    depthmapX::CsrGraph axialGraph(ShapeGraph &map, std::vector<int> &shapeRefs,
+                                   std::vector<Point2f> *midpoints = nullptr);
+
+    inline size_t segmentNode(size_t segment, bool forwards) {
+        return 2 * segment + (forwards ? 0 : 1);
+    }
+    inline size_t nodeSegment(size_t node) { return node / 2; }
+} // namespace dm_graphbuilders
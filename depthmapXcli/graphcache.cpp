@@ -0,0 +1,62 @@
+// SPDX-FileCopyrightText: 2026 depthmapX authors
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "graphcache.h"
+
+#include "runmethods.h"
+
+#include <algorithm>
+#include <exception>
+
+namespace {
+    GraphCache *currentCache = nullptr;
+} // namespace
+
+bool GraphCache::load(const std::string &filename, IPerformanceSink &perfWriter) {
+    std::error_code error;
+    auto modified = std::filesystem::last_write_time(filename, error);
+    if (error) {
+        return false;
+    }
+    auto iter = find(filename);
+    if (iter != m_entries.end()) {
+        if (iter->modified == modified) {
+            m_entries.splice(m_entries.begin(), m_entries, iter);
+            return true;
+        }
+        m_entries.erase(iter);
+    }
+
+    std::unique_ptr<MetaGraphDX> graph;
+    try {
+        graph = std::make_unique<MetaGraphDX>(dm_runmethods::loadGraph(filename, perfWriter));
+    } catch (std::exception &) {
+        // not a graph, the request will fail or read it as something else
+        return false;
+    }
+    m_entries.push_front({filename, modified, std::move(graph)});
+    if (m_entries.size() > m_capacity) {
+        m_entries.pop_back();
+    }
+    return true;
+}
+
+std::unique_ptr<MetaGraphDX> GraphCache::take(const std::string &filename) {
+    auto iter = find(filename);
+    if (iter == m_entries.end()) {
+        return nullptr;
+    }
+    auto graph = std::move(iter->graph);
+    m_entries.erase(iter);
+    return graph;
+}
+
+std::list<GraphCache::Entry>::iterator GraphCache::find(const std::string &filename) {
+    return std::find_if(m_entries.begin(), m_entries.end(),
+                        [&filename](const Entry &entry) { return entry.filename == filename; });
+}
+
+GraphCache *GraphCache::current() { return currentCache; }
+
+void GraphCache::setCurrent(GraphCache *cache) { currentCache = cache; }
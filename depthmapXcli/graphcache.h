@@ -0,0 +1,47 @@
+// SPDX-FileCopyrightText: 2026 depthmapX authors
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#pragma once
+
+#include "dxinterface/metagraphdx.h"
+#include "performancesink.h"
+
+#include <filesystem>
+#include <list>
+#include <memory>
+#include <string>
+
+// Graphs kept loaded between the requests of the server mode, the least
+// recently used going first once it is full. A graph is loaded again when its
+// file has changed since
+class GraphCache {
+  public:
+    explicit GraphCache(size_t capacity) : m_capacity(capacity) {}
+
+    // Loads the graph of the file unless it is cached as the file is now.
+    // False if the file can not be loaded as a graph
+    bool load(const std::string &filename, IPerformanceSink &perfWriter);
+    // Hands over the cached graph of the file, null if there is none. Meant
+    // for the process forked off to run one request, which has a copy of the
+    // cache of its own
+    std::unique_ptr<MetaGraphDX> take(const std::string &filename);
+    size_t size() const { return m_entries.size(); }
+
+    // the cache dm_runmethods::loadGraph takes graphs from, null for none
+    static GraphCache *current();
+    static void setCurrent(GraphCache *cache);
+
+  private:
+    struct Entry {
+        std::string filename;
+        std::filesystem::file_time_type modified;
+        std::unique_ptr<MetaGraphDX> graph;
+    };
+
+    std::list<Entry>::iterator find(const std::string &filename);
+
+    size_t m_capacity;
+    // most recently used first
+    std::list<Entry> m_entries;
+};
@@ -0,0 +1,87 @@
+// SPDX-FileCopyrightText: 2026 depthmapX authors
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "graphdiff.h"
+
+#include "shortestpathsearch.h"
+#include "taskscheduler.h"
+
+#include <algorithm>
+#include <limits>
+#include <unordered_map>
+
+namespace {
+    typedef std::vector<std::pair<int64_t, float>> KeyedEdges;
+
+    KeyedEdges keyedEdges(const depthmapX::CsrGraph &graph, const std::vector<int64_t> &keys,
+                          size_t node) {
+        KeyedEdges edges;
+        for (size_t e = graph.offsets[node]; e < graph.offsets[node + 1]; e++) {
+            edges.push_back({keys[graph.targets[e]], graph.isWeighted() ? graph.weights[e] : 1.0f});
+        }
+        std::sort(edges.begin(), edges.end());
+        return edges;
+    }
+
+    // the shortest of the distances of the nodes of a group
+    double groupDistance(const std::vector<double> &distances, const std::vector<size_t> &group) {
+        double distance = std::numeric_limits<double>::infinity();
+        for (size_t node : group) {
+            distance = std::min(distance, distances[node]);
+        }
+        return distance;
+    }
+} // namespace
+
+namespace depthmapX {
+
+    std::vector<size_t> changedNodes(const CsrGraph &base, const std::vector<int64_t> &baseKeys,
+                                     const CsrGraph &edited,
+                                     const std::vector<int64_t> &editedKeys) {
+        std::unordered_map<int64_t, size_t> baseNodes;
+        for (size_t node = 0; node < baseKeys.size(); node++) {
+            baseNodes[baseKeys[node]] = node;
+        }
+        std::vector<size_t> changed;
+        for (size_t node = 0; node < edited.numNodes(); node++) {
+            auto baseNode = baseNodes.find(editedKeys[node]);
+            if (baseNode == baseNodes.end() ||
+                keyedEdges(base, baseKeys, baseNode->second) !=
+                    keyedEdges(edited, editedKeys, node)) {
+                changed.push_back(node);
+            }
+        }
+        return changed;
+    }
+
+    ChangedPathBounds::ChangedPathBounds(const CsrGraph &graph, const CsrGraph &reverseGraph,
+                                         const std::vector<size_t> &changedNodes,
+                                         const std::vector<std::vector<size_t>> &sourceGroups,
+                                         const std::vector<std::vector<size_t>> &targetGroups)
+        : m_fromSources(changedNodes.size()), m_toTargets(changedNodes.size()) {
+        TaskScheduler::global().parallelFor(
+            0, changedNodes.size(), 1, [&](size_t begin, size_t end) {
+                ShortestPathSearch search(graph, reverseGraph);
+                for (size_t i = begin; i < end; i++) {
+                    auto toChanged = search.distancesFrom({changedNodes[i]}, true);
+                    for (const auto &group : sourceGroups) {
+                        m_fromSources[i].push_back(groupDistance(toChanged, group));
+                    }
+                    auto fromChanged = search.distancesFrom({changedNodes[i]}, false);
+                    for (const auto &group : targetGroups) {
+                        m_toTargets[i].push_back(groupDistance(fromChanged, group));
+                    }
+                }
+            });
+    }
+
+    double ChangedPathBounds::bound(size_t sourceGroup, size_t targetGroup) const {
+        double bound = std::numeric_limits<double>::infinity();
+        for (size_t i = 0; i < m_fromSources.size(); i++) {
+            bound = std::min(bound, m_fromSources[i][sourceGroup] + m_toTargets[i][targetGroup]);
+        }
+        return bound;
+    }
+
+} // namespace depthmapX
@@ -0,0 +1,50 @@
+// SPDX-FileCopyrightText: 2026 depthmapX authors
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#pragma once
+
+// What changed between two versions of a graph, and how far the changes can
+// reach, so that shortest paths calculated on the first version can be kept
+// for the second where no change can have made them shorter or broken them
+
+#include "csrgraph.h"
+
+#include <cstdint>
+#include <vector>
+
+namespace depthmapX {
+
+    // The nodes of the edited graph whose outgoing edges differ from the base
+    // graph, nodes being matched between the two by their keys (such as the
+    // ref and direction of a segment). Nodes new in the edited graph count as
+    // changed. Edges are compared by the keys of their targets and weights
+    std::vector<size_t> changedNodes(const CsrGraph &base, const std::vector<int64_t> &baseKeys,
+                                     const CsrGraph &edited,
+                                     const std::vector<int64_t> &editedKeys);
+
+    // Lower bounds on the length of the paths from groups of sources to
+    // groups of targets that leave one of the changed nodes. A path the base
+    // graph did not have has to take an edge out of a changed node, so a path
+    // of the base graph that is still there and no longer than the bound is
+    // still the shortest
+    class ChangedPathBounds {
+      public:
+        // two full searches per changed node, spread over the global task
+        // scheduler
+        ChangedPathBounds(const CsrGraph &graph, const CsrGraph &reverseGraph,
+                          const std::vector<size_t> &changedNodes,
+                          const std::vector<std::vector<size_t>> &sourceGroups,
+                          const std::vector<std::vector<size_t>> &targetGroups);
+
+        // infinity if there is no such path
+        double bound(size_t sourceGroup, size_t targetGroup) const;
+
+      private:
+        // distances between each changed node and each group, as
+        // [changed node][group]
+        std::vector<std::vector<double>> m_fromSources;
+        std::vector<std::vector<double>> m_toTargets;
+    };
+
+} // namespace depthmapX
@@ -16,5 +16,7 @@ class IModeParser {
     virtual std::string getHelp() const = 0;
     virtual void parse(size_t argc, char **argv) = 0;
     virtual void run(const CommandLineParser &clp, IPerformanceSink &perfWriter) const = 0;
+    // modes that create a graph from scratch do without -f
+    virtual bool needsInputFile() const { return true; }
     virtual ~IModeParser() {}
 };
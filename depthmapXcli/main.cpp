@@ -5,6 +5,9 @@
 #include "commandlineparser.h"
 #include "modeparserregistry.h"
 #include "performancewriter.h"
+#include "server.h"
+
+#include "salalib/genlib/comm.h"
 
 #include <iostream>
 
@@ -13,6 +16,10 @@ int main(int argc, char *argv[]) {
     CommandLineParser args(registry);
     try {
         args.parse(static_cast<size_t>(argc), argv);
+        if (!args.getServeSocket().empty()) {
+            dm_server::serve(args.getServeSocket(), args.getServeCacheSize(), registry);
+            return 0;
+        }
         if (!args.isValid()) {
             if (args.printVersionMode()) {
                 args.printVersion();
@@ -27,6 +34,9 @@ int main(int argc, char *argv[]) {
         args.run(perfWriter);
         perfWriter.write();
 
+    } catch (Communicator::CancelledException &) {
+        std::cout << "Analysis cancelled before its results could be kept" << std::endl;
+        return -1;
     } catch (std::exception &e) {
         std::cout << e.what() << "\n"
                   << "Type 'depthmapXcli -h' for help" << std::endl;
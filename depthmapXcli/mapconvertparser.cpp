@@ -66,6 +66,10 @@ void MapConvertParser::parse(size_t argc, char **argv) {
 }
 
 void MapConvertParser::run(const CommandLineParser &clp, IPerformanceSink &perfWriter) const {
+    std::string productKey;
+    if (dm_runmethods::fetchCachedProduct(clp, perfWriter, productKey)) {
+        return;
+    }
     auto metaGraph = dm_runmethods::loadGraph(clp.getFileName().c_str(), perfWriter);
 
     std::optional<std::string> mimicVersion = clp.getMimickVersion();
@@ -232,4 +236,5 @@ void MapConvertParser::run(const CommandLineParser &clp, IPerformanceSink &perfW
     DO_TIMED("Writing graph",
              dm_runmethods::writeGraph(clp, metaGraph, clp.getOuputFile().c_str(), false))
     std::cout << " ok" << std::endl;
+    dm_runmethods::storeCachedProduct(clp, productKey, perfWriter);
 }
@@ -0,0 +1,103 @@
+// SPDX-FileCopyrightText: 2026 depthmapX authors
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "mapgenerator.h"
+
+#include <algorithm>
+#include <cmath>
+#include <random>
+
+namespace {
+    // the number of cells along each side of a square grid with about the
+    // given number of cell sides (two per cell)
+    size_t gridSide(double numSides) {
+        return std::max(size_t(1), static_cast<size_t>(std::lround(std::sqrt(numSides / 2))));
+    }
+
+    // mt19937's output is the same everywhere, unlike the standard
+    // distributions
+    double unitRandom(std::mt19937 &random) {
+        return static_cast<double>(random()) / 4294967296.0;
+    }
+} // namespace
+
+namespace depthmapX {
+
+    std::vector<Line> generateStreetGrid(size_t numLines, double blockSize) {
+        size_t side = gridSide(static_cast<double>(numLines));
+        std::vector<Line> lines;
+        lines.reserve(2 * side * (side + 1));
+        for (size_t i = 0; i <= side; i++) {
+            for (size_t j = 0; j < side; j++) {
+                double along = static_cast<double>(i) * blockSize;
+                double from = static_cast<double>(j) * blockSize;
+                lines.emplace_back(Point2f(from, along), Point2f(from + blockSize, along));
+                lines.emplace_back(Point2f(along, from), Point2f(along, from + blockSize));
+            }
+        }
+        return lines;
+    }
+
+    std::vector<Line> generateCityFabric(size_t numLines, double blockSize, uint32_t seed) {
+        const double keptStreets = 0.8;
+        size_t side = gridSide(static_cast<double>(numLines) / keptStreets);
+        std::mt19937 random(seed);
+
+        std::vector<Point2f> junctions;
+        junctions.reserve((side + 1) * (side + 1));
+        for (size_t y = 0; y <= side; y++) {
+            for (size_t x = 0; x <= side; x++) {
+                double dx = (unitRandom(random) - 0.5) * 2 / 3 * blockSize;
+                double dy = (unitRandom(random) - 0.5) * 2 / 3 * blockSize;
+                junctions.emplace_back(static_cast<double>(x) * blockSize + dx,
+                                       static_cast<double>(y) * blockSize + dy);
+            }
+        }
+        auto junction = [&](size_t x, size_t y) { return junctions[y * (side + 1) + x]; };
+
+        std::vector<Line> lines;
+        for (size_t y = 0; y <= side; y++) {
+            for (size_t x = 0; x <= side; x++) {
+                if (x < side && unitRandom(random) < keptStreets) {
+                    lines.emplace_back(junction(x, y), junction(x + 1, y));
+                }
+                if (y < side && unitRandom(random) < keptStreets) {
+                    lines.emplace_back(junction(x, y), junction(x, y + 1));
+                }
+            }
+        }
+        return lines;
+    }
+
+    std::vector<Line> generateFloorPlan(size_t numRooms, double roomSize) {
+        // a side of cells per room
+        size_t side = gridSide(2 * static_cast<double>(numRooms));
+        double extent = static_cast<double>(side) * roomSize;
+        double doorWidth = roomSize / 4;
+
+        std::vector<Line> lines;
+        lines.reserve(4 + 4 * side * (side - 1));
+        lines.emplace_back(Point2f(0, 0), Point2f(extent, 0));
+        lines.emplace_back(Point2f(extent, 0), Point2f(extent, extent));
+        lines.emplace_back(Point2f(extent, extent), Point2f(0, extent));
+        lines.emplace_back(Point2f(0, extent), Point2f(0, 0));
+        for (size_t i = 1; i < side; i++) {
+            double along = static_cast<double>(i) * roomSize;
+            for (size_t j = 0; j < side; j++) {
+                // the wall between two rooms, in two halves either side of
+                // the door
+                double from = static_cast<double>(j) * roomSize;
+                double doorFrom = from + (roomSize - doorWidth) / 2;
+                double doorTo = doorFrom + doorWidth;
+                double to = from + roomSize;
+                lines.emplace_back(Point2f(from, along), Point2f(doorFrom, along));
+                lines.emplace_back(Point2f(doorTo, along), Point2f(to, along));
+                lines.emplace_back(Point2f(along, from), Point2f(along, doorFrom));
+                lines.emplace_back(Point2f(along, doorTo), Point2f(along, to));
+            }
+        }
+        return lines;
+    }
+
+} // namespace depthmapX
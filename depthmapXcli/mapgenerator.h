@@ -0,0 +1,30 @@
+// SPDX-FileCopyrightText: 2026 depthmapX authors
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#pragma once
+
+// Synthetic maps of a given size, to see how the analyses scale on inputs far
+// larger than the test data. The maps are deterministic in their parameters
+// (and seed), on every platform
+
+#include "salalib/genlib/p2dpoly.h"
+
+#include <cstdint>
+#include <vector>
+
+namespace depthmapX {
+
+    // The streets around a square grid of square blocks, one line per side
+    // of a block. A grid of c blocks a side has 2c(c + 1) lines
+    std::vector<Line> generateStreetGrid(size_t numLines, double blockSize);
+
+    // A street grid with its junctions moved at random by up to a third of a
+    // block and a fifth of its streets left out, for an irregular fabric
+    std::vector<Line> generateCityFabric(size_t numLines, double blockSize, uint32_t seed);
+
+    // The walls of a square block of square rooms, with a door in the middle
+    // of every wall between two rooms
+    std::vector<Line> generateFloorPlan(size_t numRooms, double roomSize);
+
+} // namespace depthmapX
@@ -0,0 +1,119 @@
+// SPDX-FileCopyrightText: 2026 depthmapX authors
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "mergeparser.h"
+
+#include "exceptions.h"
+#include "parsingutils.h"
+#include "runmethods.h"
+#include "simpletimer.h"
+
+#include <cstring>
+#include <fstream>
+#include <sstream>
+
+using namespace depthmapX;
+
+namespace {
+    // The csv output of a SEGMENTSHORTESTPATH OD shard holds the rows of its
+    // range of pairs, so the shards are joined by appending their rows in
+    // the order given, keeping the header of the first
+    void mergeCsvShards(const CommandLineParser &clp, const std::vector<std::string> &shardFiles) {
+        std::ofstream outStream(clp.getOuputFile());
+        std::string header;
+        for (size_t i = 0; i <= shardFiles.size(); i++) {
+            const std::string &shardFile = i == 0 ? clp.getFileName() : shardFiles[i - 1];
+            std::ifstream shardStream(shardFile);
+            if (!shardStream) {
+                std::stringstream message;
+                message << "Failed to load file " << shardFile << ", error "
+                        << std::strerror(errno) << std::flush;
+                throw RuntimeException(message.str().c_str());
+            }
+            std::string line;
+            std::getline(shardStream, line);
+            if (i == 0) {
+                header = line;
+                outStream << header << "\n";
+            } else if (line != header) {
+                throw RuntimeException("The columns of " + shardFile +
+                                       " are not the same as those of " + clp.getFileName());
+            }
+            while (std::getline(shardStream, line)) {
+                outStream << line << "\n";
+            }
+        }
+        if (!outStream) {
+            throw RuntimeException("Failed to write " + clp.getOuputFile());
+        }
+    }
+
+    bool isCsvFile(const std::string &filename) {
+        return filename.size() >= 4 && filename.compare(filename.size() - 4, 4, ".csv") == 0;
+    }
+} // namespace
+
+void MergeParser::parse(size_t argc, char *argv[]) {
+    for (size_t i = 1; i < argc;) {
+        if (std::strcmp("-mgf", argv[i]) == 0) {
+            ENFORCE_ARGUMENT("-mgf", i)
+            m_shardFiles.push_back(argv[i]);
+        }
+        ++i;
+    }
+
+    if (m_shardFiles.empty()) {
+        throw CommandLineException("At least one -mgf shard must be given");
+    }
+}
+
+void MergeParser::run(const CommandLineParser &clp, IPerformanceSink &perfWriter) const {
+    if (isCsvFile(clp.getFileName())) {
+        std::cout << "Appending the rows of " << m_shardFiles.size() << " shards... "
+                  << std::flush;
+        DO_TIMED("Merging csv shards", mergeCsvShards(clp, m_shardFiles))
+        std::cout << "ok" << std::endl;
+        return;
+    }
+
+    auto metaGraph = dm_runmethods::loadGraph(clp.getFileName().c_str(), perfWriter);
+    auto &table = metaGraph.getDisplayedMapAttributes();
+
+    size_t numMerged = 0;
+    for (const auto &shardFile : m_shardFiles) {
+        auto shardGraph = dm_runmethods::loadGraph(shardFile, perfWriter);
+        if (shardGraph.getDisplayedMapType() != metaGraph.getDisplayedMapType()) {
+            throw RuntimeException("The displayed map of " + shardFile +
+                                   " is not of the same type as that of " + clp.getFileName());
+        }
+        const auto &shardTable = shardGraph.getDisplayedMapAttributes();
+        if (shardTable.getNumRows() != table.getNumRows()) {
+            throw RuntimeException("The displayed map of " + shardFile +
+                                   " does not have the same rows as that of " +
+                                   clp.getFileName());
+        }
+
+        std::cout << "Merging columns of " << shardFile << "... " << std::flush;
+        SimpleTimer t;
+        for (size_t col = 0; col < shardTable.getNumColumns(); col++) {
+            const std::string &name = shardTable.getColumnName(col);
+            // columns the shards share were there before the analysis was split
+            if (table.hasColumn(name)) {
+                continue;
+            }
+            size_t to = table.insertOrResetColumn(name);
+            for (auto iter = shardTable.begin(); iter != shardTable.end(); ++iter) {
+                table.getRow(iter->getKey()).setValue(to, iter->getRow().getValue(col));
+            }
+            numMerged++;
+        }
+        perfWriter.addData("Merging shard columns", t.getTimeInSeconds());
+        std::cout << "ok" << std::endl;
+    }
+
+    std::cout << numMerged << " columns merged\nWriting out result..." << std::flush;
+    DO_TIMED("Writing graph",
+             dm_runmethods::writeGraph(clp, metaGraph, clp.getOuputFile().c_str(), false))
+    std::cout << " ok" << std::endl;
+}
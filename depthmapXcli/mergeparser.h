@@ -0,0 +1,34 @@
+// SPDX-FileCopyrightText: 2026 depthmapX authors
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#pragma once
+
+#include "commandlineparser.h"
+#include "imodeparser.h"
+
+#include <string>
+#include <vector>
+
+class MergeParser : public IModeParser {
+  public:
+    std::string getModeName() const override { return "MERGE"; }
+
+    std::string getHelp() const override {
+        return "Mode options for MERGE:\n"
+               "-mgf <shard> graph file of another shard of an analysis run with -or, the\n"
+               "    file given by -f being the first. Can be given more than once.\n"
+               "    The columns of the displayed map of each shard that the first shard does\n"
+               "    not have are copied over. Csv shards of SEGMENTSHORTESTPATH OD matrices\n"
+               "    are joined by appending their rows in the order given instead\n";
+    }
+
+  public:
+    void parse(size_t argc, char *argv[]) override;
+    void run(const CommandLineParser &clp, IPerformanceSink &perfWriter) const override;
+
+    const std::vector<std::string> &getShardFiles() const { return m_shardFiles; }
+
+  private:
+    std::vector<std::string> m_shardFiles;
+};
@@ -7,10 +7,12 @@
 #include "agentparser.h"
 #include "axialparser.h"
 #include "exportparser.h"
+#include "generateparser.h"
 #include "importparser.h"
 #include "isovistparser.h"
 #include "linkparser.h"
 #include "mapconvertparser.h"
+#include "mergeparser.h"
 #include "segmentparser.h"
 #include "segmentshortestpathparser.h"
 #include "stepdepthparser.h"
@@ -31,5 +33,7 @@ void ModeParserRegistry::populateParsers() {
     REGISTER_PARSER(StepDepthParser);
     REGISTER_PARSER(MapConvertParser);
     REGISTER_PARSER(SegmentShortestPathParser);
+    REGISTER_PARSER(MergeParser);
+    REGISTER_PARSER(GenerateParser);
     // *********
 }
@@ -0,0 +1,127 @@
+// SPDX-FileCopyrightText: 2026 depthmapX authors
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "multisourcebfs.h"
+
+#include "taskscheduler.h"
+
+#include <algorithm>
+#include <stdexcept>
+
+namespace {
+    // sets the depth of the node from each of the groups of the bits given
+    void setDepths(std::vector<std::vector<int>> &depths, uint64_t groups, size_t node,
+                   int depth) {
+        while (groups != 0) {
+            // index of the lowest set bit
+            size_t group = 0;
+            while (((groups >> group) & 1) == 0) {
+                group++;
+            }
+            depths[group][node] = depth;
+            groups &= groups - 1;
+        }
+    }
+} // namespace
+
+std::vector<std::vector<int>>
+depthmapX::multiSourceStepDepthBatch(const CsrGraph &graph,
+                                     const std::vector<std::vector<size_t>> &originGroups) {
+    size_t numGroups = std::min(originGroups.size(), BFS_BATCH_SIZE);
+    size_t numNodes = graph.numNodes();
+
+    std::vector<std::vector<int>> depths(numGroups, std::vector<int>(numNodes, -1));
+
+    std::vector<uint64_t> seen(numNodes, 0);
+    std::vector<uint64_t> visit(numNodes, 0);
+    std::vector<uint64_t> visitNext(numNodes, 0);
+
+    std::vector<size_t> frontier;
+    std::vector<size_t> nextFrontier;
+
+    for (size_t group = 0; group < numGroups; group++) {
+        uint64_t bit = uint64_t(1) << group;
+        for (size_t origin : originGroups[group]) {
+            if (origin >= numNodes) {
+                throw std::out_of_range("Origin outside of graph");
+            }
+            if (visit[origin] == 0) {
+                frontier.push_back(origin);
+            }
+            seen[origin] |= bit;
+            visit[origin] |= bit;
+            depths[group][origin] = 0;
+        }
+    }
+
+    int level = 0;
+    while (!frontier.empty()) {
+        level++;
+        if (graph.isWeighted()) {
+            // first the nodes at the depth of the frontier joined to it by
+            // edges of weight 0, so that they are seen before any of them is
+            // found a step further on
+            for (size_t i = 0; i < frontier.size(); i++) {
+                size_t node = frontier[i];
+                for (size_t e = graph.offsets[node]; e < graph.offsets[node + 1]; e++) {
+                    size_t neighbour = graph.targets[e];
+                    uint64_t discovered = visit[node] & ~seen[neighbour];
+                    if (discovered != 0 && graph.weights[e] == 0.0f) {
+                        // again if already in the frontier, to carry on the
+                        // new bits
+                        frontier.push_back(neighbour);
+                        visit[neighbour] |= discovered;
+                        seen[neighbour] |= discovered;
+                        setDepths(depths, discovered, neighbour, level - 1);
+                    }
+                }
+            }
+        }
+        for (size_t node : frontier) {
+            uint64_t current = visit[node];
+            for (size_t e = graph.offsets[node]; e < graph.offsets[node + 1]; e++) {
+                size_t neighbour = graph.targets[e];
+                uint64_t discovered = current & ~seen[neighbour];
+                if (discovered != 0) {
+                    if (visitNext[neighbour] == 0) {
+                        nextFrontier.push_back(neighbour);
+                    }
+                    visitNext[neighbour] |= discovered;
+                    seen[neighbour] |= discovered;
+                }
+            }
+            visit[node] = 0;
+        }
+        for (size_t node : nextFrontier) {
+            setDepths(depths, visitNext[node], node, level);
+            visit[node] = visitNext[node];
+            visitNext[node] = 0;
+        }
+        frontier.swap(nextFrontier);
+        nextFrontier.clear();
+    }
+    return depths;
+}
+
+std::vector<std::vector<int>>
+depthmapX::multiSourceStepDepth(const CsrGraph &graph,
+                                const std::vector<std::vector<size_t>> &originGroups,
+                                const CancellationToken &token) {
+    std::vector<std::vector<int>> depths(originGroups.size());
+    size_t numBatches = (originGroups.size() + BFS_BATCH_SIZE - 1) / BFS_BATCH_SIZE;
+    TaskScheduler::global().parallelFor(0, numBatches, 1, [&](size_t batchBegin, size_t batchEnd) {
+        for (size_t batchIndex = batchBegin; batchIndex < batchEnd && !token.isCancelled();
+             batchIndex++) {
+            size_t start = batchIndex * BFS_BATCH_SIZE;
+            size_t end = std::min(start + BFS_BATCH_SIZE, originGroups.size());
+            std::vector<std::vector<size_t>> batch(originGroups.begin() + static_cast<long>(start),
+                                                   originGroups.begin() + static_cast<long>(end));
+            auto batchDepths = multiSourceStepDepthBatch(graph, batch);
+            for (size_t group = 0; group < batchDepths.size(); group++) {
+                depths[start + group] = std::move(batchDepths[group]);
+            }
+        }
+    });
+    return depths;
+}
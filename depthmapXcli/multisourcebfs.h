@@ -0,0 +1,38 @@
+// SPDX-FileCopyrightText: 2026 depthmapX authors
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#pragma once
+
+// Multi-source breadth first search. Up to 64 independent searches are carried
+// in the bits of one word per node, so that a single sweep over the graph
+// advances all of their frontiers at once. An origin group may contain more
+// than one node, in which case its depth is the depth from the nearest member.
+// In a weighted graph edges of weight 0 join nodes at the same depth, as the
+// links between merged pixels do in salalib's visual step depth, and any other
+// weight counts as one step
+
+#include "cancellationtoken.h"
+#include "csrgraph.h"
+
+#include <cstdint>
+#include <vector>
+
+namespace depthmapX {
+
+    static constexpr size_t BFS_BATCH_SIZE = 64;
+
+    // Step depths from each group, indexed as [group][node], -1 if unreachable.
+    // Processes at most BFS_BATCH_SIZE groups, the rest are ignored
+    std::vector<std::vector<int>>
+    multiSourceStepDepthBatch(const CsrGraph &graph,
+                              const std::vector<std::vector<size_t>> &originGroups);
+
+    // As above for any number of groups, run in batches of BFS_BATCH_SIZE
+    // spread over the global task scheduler. The batches not started before
+    // the token is cancelled are left out, their groups given no depths
+    std::vector<std::vector<int>> multiSourceStepDepth(
+        const CsrGraph &graph, const std::vector<std::vector<size_t>> &originGroups,
+        const CancellationToken &token = CancellationToken::global());
+
+} // namespace depthmapX
@@ -4,27 +4,151 @@
 
 #include "printcommunicator.h"
 
-#include <iostream>
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+
+PrintCommunicator::PrintCommunicator(std::ostream *stream, const std::string &progressFile,
+                                     std::chrono::milliseconds interval,
+                                     const depthmapX::CancellationToken *token)
+    : m_stream(stream), m_progressFile(progressFile), m_interval(interval),
+      m_start(std::chrono::steady_clock::now()), m_token(token),
+      m_stepStart(m_start.time_since_epoch().count()) {
+    m_numSteps = 0;
+    m_step = 0;
+    m_numRecords = 0;
+    m_record = 0;
+    m_reporter = std::thread(&PrintCommunicator::reporterLoop, this);
+}
+
+PrintCommunicator::~PrintCommunicator() {
+    {
+        std::lock_guard<std::mutex> lock(m_stopMutex);
+        m_stopping = true;
+    }
+    m_stop.notify_all();
+    m_reporter.join();
+    report(false);
+}
 
 void PrintCommunicator::CommPostMessage(size_t m, size_t x) const {
     switch (m) {
     case Communicator::NUM_STEPS:
-        m_numSteps = x;
+        m_numStepsPosted = x;
         break;
     case Communicator::CURRENT_STEP:
-        m_step = x;
+        m_stepPosted = x;
+        m_stepStart = std::chrono::steady_clock::now().time_since_epoch().count();
         break;
     case Communicator::NUM_RECORDS:
-        m_numRecords = x;
+        m_numRecordsPosted = x;
+        m_stepStart = std::chrono::steady_clock::now().time_since_epoch().count();
         break;
     case Communicator::CURRENT_RECORD:
-        m_record = x;
-        if (m_record > m_numRecords)
-            m_record = m_numRecords;
-        std::cout << "step: " << m_step << "/" << m_numSteps << " "
-                  << "record: " << m_record << "/" << m_numRecords << std::endl;
+        m_recordPosted = x;
         break;
     default:
         break;
     }
 }
+
+PrintCommunicator::Progress PrintCommunicator::progress() const {
+    auto now = std::chrono::steady_clock::now();
+    Progress progress;
+    progress.numSteps = m_numStepsPosted;
+    progress.step = m_stepPosted;
+    progress.numRecords = m_numRecordsPosted;
+    progress.record = std::min(m_recordPosted.load(), progress.numRecords);
+    progress.elapsed = std::chrono::duration<double>(now - m_start).count();
+
+    std::chrono::steady_clock::time_point stepStart{
+        std::chrono::steady_clock::duration(m_stepStart.load())};
+    double stepElapsed = std::chrono::duration<double>(now - stepStart).count();
+    progress.recordsPerSecond =
+        stepElapsed > 0 ? static_cast<double>(progress.record) / stepElapsed : 0;
+    progress.eta = progress.recordsPerSecond > 0
+                       ? static_cast<double>(progress.numRecords - progress.record) /
+                             progress.recordsPerSecond
+                       : -1;
+    return progress;
+}
+
+std::string PrintCommunicator::formatDuration(double seconds) {
+    long total = std::lround(std::max(0.0, seconds));
+    std::stringstream out;
+    out << std::setfill('0');
+    if (total < 60) {
+        out << total << "s";
+    } else if (total < 3600) {
+        out << total / 60 << "m" << std::setw(2) << total % 60 << "s";
+    } else {
+        out << total / 3600 << "h" << std::setw(2) << total / 60 % 60 << "m";
+    }
+    return out.str();
+}
+
+void PrintCommunicator::report(bool running) {
+    Progress current = progress();
+
+    if (m_stream && (current.step != m_lastPrintedStep || current.record != m_lastPrintedRecord)) {
+        m_lastPrintedStep = current.step;
+        m_lastPrintedRecord = current.record;
+        std::stringstream line;
+        line << "step: " << current.step << "/" << current.numSteps << " "
+             << "record: " << current.record << "/" << current.numRecords;
+        if (current.numRecords > 0) {
+            line << " (" << std::fixed << std::setprecision(1)
+                 << 100.0 * static_cast<double>(current.record) /
+                        static_cast<double>(current.numRecords)
+                 << "%), " << std::setprecision(0) << current.recordsPerSecond << " records/s";
+            if (running && current.eta >= 0) {
+                line << ", ETA " << formatDuration(current.eta);
+            }
+        }
+        line << "\n";
+        *m_stream << line.str() << std::flush;
+    }
+
+    if (!m_progressFile.empty()) {
+        // written next to the file and moved over it, so that a reader never
+        // sees a partially written file
+        std::string tempFile = m_progressFile + ".tmp";
+        {
+            std::ofstream file(tempFile);
+            file << "{\"running\": " << (running ? "true" : "false")
+                 << ", \"step\": " << current.step << ", \"numSteps\": " << current.numSteps
+                 << ", \"record\": " << current.record
+                 << ", \"numRecords\": " << current.numRecords << std::fixed
+                 << std::setprecision(3) << ", \"elapsedSeconds\": " << current.elapsed
+                 << ", \"recordsPerSecond\": " << current.recordsPerSecond
+                 << ", \"etaSeconds\": ";
+            if (running && current.eta >= 0) {
+                file << current.eta;
+            } else {
+                file << "null";
+            }
+            file << "}\n";
+        }
+        if (std::rename(tempFile.c_str(), m_progressFile.c_str()) != 0) {
+            // rename does not replace an existing file everywhere
+            std::remove(m_progressFile.c_str());
+            std::rename(tempFile.c_str(), m_progressFile.c_str());
+        }
+    }
+}
+
+void PrintCommunicator::reporterLoop() {
+    std::unique_lock<std::mutex> lock(m_stopMutex);
+    while (!m_stop.wait_for(lock, m_interval, [this]() { return m_stopping; })) {
+        if (m_token && m_token->isCancelled() && !IsCancelled()) {
+            Cancel();
+            if (m_stream) {
+                *m_stream << "cancelled, stopping at the next record\n" << std::flush;
+            }
+        }
+        report(true);
+    }
+}
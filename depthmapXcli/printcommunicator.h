@@ -4,16 +4,74 @@
 
 #pragma once
 
+#include "cancellationtoken.h"
+
 #include "salalib/genlib/comm.h"
 
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <iostream>
+#include <mutex>
+#include <string>
+#include <thread>
+
+// Progress messages only update atomic counters, so that they are cheap and
+// can be posted from any thread. A reporter thread prints the progress at a
+// fixed interval, with the throughput and the estimated time left of the
+// current step, and optionally rewrites a JSON progress file that other
+// processes can poll. Given a cancellation token, the reporter thread also
+// cancels the communicator once the token is cancelled, which the analyses
+// check between records
 class PrintCommunicator : public ICommunicator {
   public:
-    PrintCommunicator() {
-        m_numSteps = 0;
-        m_step = 0;
-        m_numRecords = 0;
-        m_record = 0;
-    }
-    ~PrintCommunicator() override {}
+    // stream may be null to only write the progress file
+    explicit PrintCommunicator(std::ostream *stream = &std::cout,
+                               const std::string &progressFile = std::string(),
+                               std::chrono::milliseconds interval = std::chrono::seconds(1),
+                               const depthmapX::CancellationToken *token = nullptr);
+    // reports the final state
+    ~PrintCommunicator() override;
+    PrintCommunicator(const PrintCommunicator &) = delete;
+    PrintCommunicator &operator=(const PrintCommunicator &) = delete;
+
     void CommPostMessage(size_t m, size_t x) const override;
+
+    // e.g. 45s, 3m05s, 2h10m
+    static std::string formatDuration(double seconds);
+
+  private:
+    struct Progress {
+        size_t numSteps, step, numRecords, record;
+        double elapsed, recordsPerSecond;
+        // negative if unknown
+        double eta;
+    };
+
+    Progress progress() const;
+    void report(bool running);
+    void reporterLoop();
+
+    std::ostream *m_stream;
+    std::string m_progressFile;
+    std::chrono::milliseconds m_interval;
+    std::chrono::steady_clock::time_point m_start;
+    const depthmapX::CancellationToken *m_token;
+
+    mutable std::atomic<size_t> m_numStepsPosted{0};
+    mutable std::atomic<size_t> m_stepPosted{0};
+    mutable std::atomic<size_t> m_numRecordsPosted{0};
+    mutable std::atomic<size_t> m_recordPosted{0};
+    // start of the current step, in steady clock ticks, to work out the rate
+    mutable std::atomic<std::chrono::steady_clock::rep> m_stepStart;
+
+    // last step and record printed, so that nothing is printed while
+    // nothing moves
+    size_t m_lastPrintedStep = static_cast<size_t>(-1);
+    size_t m_lastPrintedRecord = static_cast<size_t>(-1);
+
+    std::mutex m_stopMutex;
+    std::condition_variable m_stop;
+    bool m_stopping = false;
+    std::thread m_reporter;
 };
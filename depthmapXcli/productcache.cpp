@@ -0,0 +1,87 @@
+// SPDX-FileCopyrightText: 2026 depthmapX authors
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "productcache.h"
+
+#include "salalib/genlib/exceptions.h"
+
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <random>
+#include <sstream>
+
+namespace {
+    void fnv1a(uint64_t &hash, const char *data, size_t size) {
+        for (size_t i = 0; i < size; i++) {
+            hash ^= static_cast<unsigned char>(data[i]);
+            hash *= 1099511628211ull;
+        }
+    }
+
+    void hashFile(uint64_t &hash, const std::string &filename) {
+        std::ifstream stream(filename, std::ios::binary);
+        if (!stream) {
+            throw depthmapX::RuntimeException("Failed to read " + filename +
+                                              " for the product cache");
+        }
+        std::vector<char> buffer(1 << 16);
+        while (stream) {
+            stream.read(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+            fnv1a(hash, buffer.data(), static_cast<size_t>(stream.gcount()));
+        }
+    }
+} // namespace
+
+namespace depthmapX {
+
+    std::string ProductCache::key(const std::string &inputFile,
+                                  const std::vector<std::string> &options,
+                                  const std::vector<std::string> &dataFiles) {
+        uint64_t hash = 14695981039346656037ull;
+        hashFile(hash, inputFile);
+        for (const auto &option : options) {
+            // with the terminating zero, so that "-a b" and "-ab" differ
+            fnv1a(hash, option.c_str(), option.size() + 1);
+        }
+        for (const auto &dataFile : dataFiles) {
+            hashFile(hash, dataFile);
+        }
+        std::stringstream key;
+        key << std::hex << hash;
+        return key.str();
+    }
+
+    std::string ProductCache::productFile(const std::string &key) const {
+        return (std::filesystem::path(m_directory) / (key + ".product")).string();
+    }
+
+    bool ProductCache::fetch(const std::string &key, const std::string &outputFile) const {
+        std::error_code error;
+        std::filesystem::copy_file(productFile(key), outputFile,
+                                   std::filesystem::copy_options::overwrite_existing, error);
+        return !error;
+    }
+
+    void ProductCache::store(const std::string &key, const std::string &outputFile) const {
+        std::error_code error;
+        std::filesystem::create_directories(m_directory, error);
+        // copied under a name of its own and moved into place, so that runs
+        // storing the same product at once do not see each other's partial
+        // copies
+        std::stringstream tempFile;
+        tempFile << productFile(key) << "." << std::hex << std::random_device()() << ".tmp";
+        std::filesystem::copy_file(outputFile, tempFile.str(),
+                                   std::filesystem::copy_options::overwrite_existing, error);
+        if (!error) {
+            std::filesystem::rename(tempFile.str(), productFile(key), error);
+        }
+        if (error) {
+            std::filesystem::remove(tempFile.str(), error);
+            throw RuntimeException("Failed to store " + outputFile + " in the product cache " +
+                                   m_directory);
+        }
+    }
+
+} // namespace depthmapX
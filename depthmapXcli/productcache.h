@@ -0,0 +1,43 @@
+// SPDX-FileCopyrightText: 2026 depthmapX authors
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#pragma once
+
+// On-disk cache of the output files of runs that are deterministic in their
+// input, such as making the visibility graph, the all-line map or converting
+// maps. Outputs are stored under a hash of the contents of the input file, the
+// options of the run and the contents of any other files the options name, so
+// that a pipeline run again with only later steps
+// changed finds the products of the earlier steps in the cache
+
+#include <string>
+#include <vector>
+
+namespace depthmapX {
+
+    class ProductCache {
+      public:
+        explicit ProductCache(const std::string &directory) : m_directory(directory) {}
+
+        // Hash of the contents of the input file, the options and the
+        // contents of the data files the options name (as these may change
+        // under the same name), in hex. Throws a RuntimeException if any of
+        // the files can not be read
+        static std::string key(const std::string &inputFile,
+                               const std::vector<std::string> &options,
+                               const std::vector<std::string> &dataFiles = {});
+
+        // copies the product stored under the key to the output file, false
+        // if there is none
+        bool fetch(const std::string &key, const std::string &outputFile) const;
+        // stores a copy of the output file under the key
+        void store(const std::string &key, const std::string &outputFile) const;
+
+      private:
+        std::string productFile(const std::string &key) const;
+
+        std::string m_directory;
+    };
+
+} // namespace depthmapX
@@ -0,0 +1,108 @@
+// SPDX-FileCopyrightText: 2026 depthmapX authors
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "radixheap.h"
+
+#include <algorithm>
+#include <cstring>
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+namespace depthmapX {
+
+    // Non-negative doubles sort the same way as their bit patterns read as
+    // unsigned integers, which is what the buckets are built on
+    uint64_t RadixHeap::toKey(double distance) {
+        if (!(distance > 0)) {
+            return 0;
+        }
+        uint64_t key;
+        std::memcpy(&key, &distance, sizeof(key));
+        return key;
+    }
+
+    double RadixHeap::fromKey(uint64_t key) {
+        double distance;
+        std::memcpy(&distance, &key, sizeof(distance));
+        return distance;
+    }
+
+    // one past the highest bit in which the key differs from the last key
+    // popped, 0 if it is the same
+    int RadixHeap::bucketIndex(uint64_t key) const {
+        uint64_t difference = key ^ m_last;
+        if (difference == 0) {
+            return 0;
+        }
+#if defined(__GNUC__)
+        return 64 - __builtin_clzll(difference);
+#elif defined(_MSC_VER) && defined(_M_X64)
+        unsigned long highest;
+        _BitScanReverse64(&highest, difference);
+        return static_cast<int>(highest) + 1;
+#else
+        int index = 1;
+        for (int shift = 32; shift > 0; shift /= 2) {
+            if (difference >> shift) {
+                difference >>= shift;
+                index += shift;
+            }
+        }
+        return index;
+#endif
+    }
+
+    void RadixHeap::push(double distance, size_t node) {
+        uint64_t key = std::max(toKey(distance), m_last);
+        m_buckets[bucketIndex(key)].push_back({key, node});
+        m_size++;
+    }
+
+    void RadixHeap::pull() {
+        if (!m_buckets[0].empty()) {
+            return;
+        }
+        int index = 1;
+        while (m_buckets[index].empty()) {
+            index++;
+        }
+        // all the entries of the first non-empty bucket agree with its
+        // smallest key on more bits than with the previous last key, so they
+        // all move to lower buckets
+        auto &bucket = m_buckets[index];
+        m_last = bucket.front().first;
+        for (const auto &entry : bucket) {
+            m_last = std::min(m_last, entry.first);
+        }
+        for (const auto &entry : bucket) {
+            m_buckets[bucketIndex(entry.first)].push_back(entry);
+        }
+        bucket.clear();
+    }
+
+    RadixHeap::Entry RadixHeap::top() {
+        pull();
+        const auto &entry = m_buckets[0].back();
+        return {fromKey(entry.first), entry.second};
+    }
+
+    RadixHeap::Entry RadixHeap::pop() {
+        pull();
+        auto entry = m_buckets[0].back();
+        m_buckets[0].pop_back();
+        m_size--;
+        return {fromKey(entry.first), entry.second};
+    }
+
+    void RadixHeap::clear() {
+        for (auto &bucket : m_buckets) {
+            bucket.clear();
+        }
+        m_last = 0;
+        m_size = 0;
+    }
+
+} // namespace depthmapX
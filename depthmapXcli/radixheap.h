@@ -0,0 +1,51 @@
+// SPDX-FileCopyrightText: 2026 depthmapX authors
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#pragma once
+
+// Monotone priority queue of (distance, node) entries for Dijkstra-like
+// searches, where nothing is ever pushed below the last distance popped. The
+// distances are bucketed by the highest bit in which they differ from the last
+// one popped, so each entry is moved between buckets at most 64 times over its
+// life and no comparisons are made between entries outside the bucket being
+// emptied. Distances must not be negative. A distance pushed below the last
+// one popped (which can only happen through rounding, e.g. with a consistent
+// A* heuristic) is raised to it
+
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+namespace depthmapX {
+
+    class RadixHeap {
+      public:
+        typedef std::pair<double, size_t> Entry;
+
+        void push(double distance, size_t node);
+        // the entry with the smallest distance, the queue must not be empty
+        Entry top();
+        Entry pop();
+
+        bool empty() const { return m_size == 0; }
+        size_t size() const { return m_size; }
+        // empties the queue, keeping the memory of its buckets
+        void clear();
+
+      private:
+        static const int NUM_BUCKETS = 65;
+
+        static uint64_t toKey(double distance);
+        static double fromKey(uint64_t key);
+        int bucketIndex(uint64_t key) const;
+        // moves the smallest entries to the first bucket if it is empty
+        void pull();
+
+        std::vector<std::pair<uint64_t, size_t>> m_buckets[NUM_BUCKETS];
+        uint64_t m_last = 0;
+        size_t m_size = 0;
+    };
+
+} // namespace depthmapX
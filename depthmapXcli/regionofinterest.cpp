@@ -0,0 +1,35 @@
+// SPDX-FileCopyrightText: 2026 depthmapX authors
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "regionofinterest.h"
+
+#include "salalib/genlib/exceptions.h"
+
+#include <string>
+
+namespace depthmapX {
+
+    RegionOfInterest::RegionOfInterest(std::vector<Point2f> polygon)
+        : m_polygon(std::move(polygon)) {
+        if (m_polygon.size() < 3) {
+            throw RuntimeException("A region of interest needs at least 3 points, got " +
+                                   std::to_string(m_polygon.size()));
+        }
+    }
+
+    bool RegionOfInterest::contains(const Point2f &point) const {
+        bool inside = false;
+        for (size_t i = 0, j = m_polygon.size() - 1; i < m_polygon.size(); j = i++) {
+            const Point2f &a = m_polygon[i];
+            const Point2f &b = m_polygon[j];
+            // edges crossing the horizontal through the point, to its right
+            if ((a.y > point.y) != (b.y > point.y) &&
+                point.x < (b.x - a.x) * (point.y - a.y) / (b.y - a.y) + a.x) {
+                inside = !inside;
+            }
+        }
+        return inside;
+    }
+
+} // namespace depthmapX
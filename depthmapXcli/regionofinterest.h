@@ -0,0 +1,31 @@
+// SPDX-FileCopyrightText: 2026 depthmapX authors
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#pragma once
+
+// A polygon around the part of a map that results are needed for, such as a
+// redevelopment site. Analyses only start from origins inside it, while their
+// searches still run over the whole map
+
+#include "salalib/genlib/p2dpoly.h"
+
+#include <vector>
+
+namespace depthmapX {
+
+    class RegionOfInterest {
+      public:
+        // Throws a RuntimeException if the polygon has fewer than 3 points
+        explicit RegionOfInterest(std::vector<Point2f> polygon);
+
+        // by the even-odd rule, the polygon being closed from its last point
+        // back to its first
+        bool contains(const Point2f &point) const;
+        const std::vector<Point2f> &getPolygon() const { return m_polygon; }
+
+      private:
+        std::vector<Point2f> m_polygon;
+    };
+
+} // namespace depthmapX
@@ -5,15 +5,28 @@
 
 #include "runmethods.h"
 
+#include "brandeschoice.h"
+#include "graphcache.h"
 #include "printcommunicator.h"
+#include "productcache.h"
 #include "simpletimer.h"
 
+#include "salalib/entityparsing.h"
+
+#include <cstring>
+#include <fstream>
 #include <memory>
 #include <sstream>
 #include <vector>
 
 namespace dm_runmethods {
     MetaGraphDX loadGraph(const std::string &filename, IPerformanceSink &perfWriter) {
+        if (GraphCache::current()) {
+            if (auto cached = GraphCache::current()->take(filename)) {
+                std::cout << "Using loaded graph " << filename << "\n" << std::flush;
+                return std::move(*cached);
+            }
+        }
         std::cout << "Loading graph " << filename << std::flush;
         MetaGraphDX mgraph("Test mgraph");
         DO_TIMED("Load graph file", mgraph.readFromFile(filename);)
@@ -29,8 +42,10 @@ namespace dm_runmethods {
     }
 
     std::unique_ptr<Communicator> getCommunicator(const CommandLineParser &clp) {
-        if (clp.printProgress()) {
-            return std::unique_ptr<Communicator>(new PrintCommunicator());
+        if (clp.printProgress() || !clp.getProgressFile().empty() || clp.getTimeBudget() > 0) {
+            return std::unique_ptr<Communicator>(new PrintCommunicator(
+                clp.printProgress() ? &std::cout : nullptr, clp.getProgressFile(),
+                std::chrono::seconds(1), &depthmapX::CancellationToken::global()));
         }
         return nullptr;
     }
@@ -38,4 +53,130 @@ namespace dm_runmethods {
                     const std::string &filename, bool currentlayer) {
         metaGraph.write(filename, METAGRAPH_VERSION, currentlayer, clp.ignoreDisplayData());
     }
+
+    bool fetchCachedProduct(const CommandLineParser &clp, IPerformanceSink &perfWriter,
+                            std::string &key, std::vector<std::string> dataFiles) {
+        key.clear();
+        if (clp.getCacheDirectory().empty()) {
+            return false;
+        }
+        depthmapX::ProductCache cache(clp.getCacheDirectory());
+        SimpleTimer timer;
+        if (!clp.getRegionOfInterestFile().empty()) {
+            dataFiles.push_back(clp.getRegionOfInterestFile());
+        }
+        key = depthmapX::ProductCache::key(clp.getFileName(), clp.getProductOptions(), dataFiles);
+        bool found = cache.fetch(key, clp.getOuputFile());
+        perfWriter.addData(found ? "Product cache hit" : "Product cache miss",
+                           timer.getTimeInSeconds());
+        if (found) {
+            std::cout << "Using cached product " << key << "\n" << std::flush;
+        }
+        return found;
+    }
+
+    void storeCachedProduct(const CommandLineParser &clp, const std::string &key,
+                            IPerformanceSink &perfWriter,
+                            const depthmapX::CancellationToken &token) {
+        if (key.empty()) {
+            return;
+        }
+        if (token.isCancelled()) {
+            std::cout << "Not caching the product of a cancelled run\n" << std::flush;
+            return;
+        }
+        DO_TIMED("Product cache store",
+                 depthmapX::ProductCache(clp.getCacheDirectory()).store(key, clp.getOuputFile()))
+    }
+
+    std::optional<depthmapX::RegionOfInterest> loadRegionOfInterest(const CommandLineParser &clp) {
+        if (clp.getRegionOfInterestFile().empty()) {
+            return std::nullopt;
+        }
+        std::ifstream stream(clp.getRegionOfInterestFile());
+        if (!stream) {
+            std::stringstream message;
+            message << "Failed to load file " << clp.getRegionOfInterestFile() << ", error "
+                    << std::strerror(errno) << std::flush;
+            throw depthmapX::RuntimeException(message.str().c_str());
+        }
+        return depthmapX::RegionOfInterest(EntityParsing::parsePoints(stream, '\t'));
+    }
+
+    void runSampledCentrality(const CommandLineParser &clp, IPerformanceSink &perfWriter,
+                              const depthmapX::CsrGraph &graph, size_t nodesPerElement,
+                              const std::vector<Point2f> &positions, const std::vector<int> &keys,
+                              bool withChoice, bool hhIntegration, const std::string &prefix,
+                              AttributeTable &table, double depthUnit) {
+        auto sample =
+            depthmapX::stratifiedSample(positions, clp.getSampleFraction(), clp.getSampleSeed());
+        std::cout << "sampling " << sample.origins.size() << " of " << positions.size()
+                  << " origins... " << std::flush;
+        depthmapX::CentralityEstimate estimate;
+        DO_TIMED("Sampled analysis",
+                 estimate = depthmapX::estimateCentrality(graph, graph.reversed(), nodesPerElement,
+                                                          sample, withChoice))
+
+        ColumnWriter writer(table, keys);
+        const std::string suffix = " [Sampled]";
+        const std::string errorSuffix = " [Sampled CI95]";
+        size_t meanDepthCol = table.insertOrResetColumn(prefix + "Mean Depth" + suffix);
+        size_t meanDepthErrorCol = table.insertOrResetColumn(prefix + "Mean Depth" + errorSuffix);
+        size_t nodeCountCol = table.insertOrResetColumn(prefix + "Node Count" + suffix);
+        size_t integrationCol = table.insertOrResetColumn(
+            prefix + (hhIntegration ? "Integration [HH]" : "Integration") + suffix);
+        size_t choiceCol = 0, choiceErrorCol = 0;
+        if (withChoice) {
+            choiceCol = table.insertOrResetColumn(prefix + "Choice" + suffix);
+            choiceErrorCol = table.insertOrResetColumn(prefix + "Choice" + errorSuffix);
+        }
+        for (size_t i = 0; i < keys.size(); i++) {
+            auto &row = writer.row(i);
+            double meanDepth = estimate.meanDepth[i];
+            double meanDepthError = estimate.meanDepthError[i];
+            if (meanDepth > 0) {
+                meanDepth *= depthUnit;
+                meanDepthError *= depthUnit;
+            }
+            // the node counts of the measures include the element itself
+            double nodeCount = estimate.nodeCount[i] + 1;
+            double integration = -1;
+            if (meanDepth > 0) {
+                integration = hhIntegration ? depthmapX::integrationHH(meanDepth, nodeCount)
+                                            : nodeCount * nodeCount /
+                                                  (meanDepth * estimate.nodeCount[i]);
+            }
+            row.setValue(meanDepthCol, static_cast<float>(meanDepth));
+            row.setValue(meanDepthErrorCol, static_cast<float>(meanDepthError));
+            row.setValue(nodeCountCol, static_cast<float>(nodeCount));
+            row.setValue(integrationCol, static_cast<float>(integration));
+            if (withChoice) {
+                row.setValue(choiceCol, static_cast<float>(estimate.choice[i]));
+                row.setValue(choiceErrorCol, static_cast<float>(estimate.choiceError[i]));
+            }
+        }
+    }
+
+    void runBrandesChoice(IPerformanceSink &perfWriter, const depthmapX::CsrGraph &graph,
+                          size_t nodesPerElement, const std::vector<int> &keys,
+                          const std::string &columnName, AttributeTable &table) {
+        std::vector<double> choice;
+        DO_TIMED("Brandes choice", choice = depthmapX::brandesChoice(graph, nodesPerElement))
+        ColumnWriter(table, keys).write(columnName, choice);
+    }
+
+    ColumnWriter::ColumnWriter(AttributeTable &table, const std::vector<int> &keys)
+        : m_table(table) {
+        m_rows.reserve(keys.size());
+        for (auto iter = table.begin(); iter != table.end() && m_rows.size() < keys.size();
+             ++iter) {
+            if (iter->getKey().value != keys[m_rows.size()]) {
+                break;
+            }
+            m_rows.push_back(&iter->getRow());
+        }
+        for (size_t i = m_rows.size(); i < keys.size(); i++) {
+            m_rows.push_back(&table.getRow(AttributeKey(keys[i])));
+        }
+    }
 } // namespace dm_runmethods
@@ -5,10 +5,14 @@
 
 #pragma once
 
+#include "cancellationtoken.h"
 #include "commandlineparser.h"
 #include "dxinterface/metagraphdx.h"
 #include "performancesink.h"
+#include "regionofinterest.h"
+#include "sampledcentrality.h"
 
+#include <optional>
 #include <string>
 #include <vector>
 
@@ -27,4 +31,58 @@ namespace dm_runmethods {
     std::unique_ptr<Communicator> getCommunicator(const CommandLineParser &clp);
     void writeGraph(const CommandLineParser &clp, MetaGraphDX &metaGraph,
                     const std::string &filename, bool currentlayer);
+    // With -cd, copies the output of an earlier run with the same input file,
+    // options and contents of the files they name (the mode's own given as
+    // data files, -roi added here) to the output file and returns true.
+    // Otherwise returns false, setting the key to store the output under once
+    // it is written, empty if there is no cache
+    bool fetchCachedProduct(const CommandLineParser &clp, IPerformanceSink &perfWriter,
+                            std::string &key, std::vector<std::string> dataFiles = {});
+    // Stores the output under the key, unless the run was cancelled and so
+    // may have only written part of it
+    void storeCachedProduct(
+        const CommandLineParser &clp, const std::string &key, IPerformanceSink &perfWriter,
+        const depthmapX::CancellationToken &token = depthmapX::CancellationToken::global());
+    // the polygon given with -roi, if any
+    std::optional<depthmapX::RegionOfInterest> loadRegionOfInterest(const CommandLineParser &clp);
+    // Writes the results of a cli kernel to the rows of the given keys,
+    // finding each row once for all the columns written. The graph builders
+    // list the keys in the order of the table, so the rows are found by
+    // walking it and are only looked up one by one from the first key out of
+    // order on
+    class ColumnWriter {
+      public:
+        ColumnWriter(AttributeTable &table, const std::vector<int> &keys);
+
+        AttributeRow &row(size_t i) { return *m_rows[i]; }
+
+        // values in the order of the keys, returns the index of the column
+        template <typename T> size_t write(const std::string &name, const std::vector<T> &values) {
+            size_t col = m_table.insertOrResetColumn(name);
+            for (size_t i = 0; i < m_rows.size(); i++) {
+                m_rows[i]->setValue(col, static_cast<float>(values[i]));
+            }
+            return col;
+        }
+
+      private:
+        AttributeTable &m_table;
+        std::vector<AttributeRow *> m_rows;
+    };
+    // With -sa, estimates mean depth, integration and (if asked for) choice
+    // from a sample of the elements at the given positions, and writes them to
+    // the rows of the given keys in columns named with the prefix and marked
+    // [Sampled]. hhIntegration picks Hillier and Hanson's integration over
+    // node count squared over total depth (as in tulip analysis). Depths are
+    // scaled by depthUnit, the depth of one unit of the weights of the graph
+    void runSampledCentrality(const CommandLineParser &clp, IPerformanceSink &perfWriter,
+                              const depthmapX::CsrGraph &graph, size_t nodesPerElement,
+                              const std::vector<Point2f> &positions, const std::vector<int> &keys,
+                              bool withChoice, bool hhIntegration, const std::string &prefix,
+                              AttributeTable &table, double depthUnit = 1.0);
+    // Choice by Brandes accumulation over all ordered pairs of elements,
+    // written to the rows of the given keys in the named column
+    void runBrandesChoice(IPerformanceSink &perfWriter, const depthmapX::CsrGraph &graph,
+                          size_t nodesPerElement, const std::vector<int> &keys,
+                          const std::string &columnName, AttributeTable &table);
 } // namespace dm_runmethods
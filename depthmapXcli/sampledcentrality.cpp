@@ -0,0 +1,262 @@
+// SPDX-FileCopyrightText: 2026 depthmapX authors
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "sampledcentrality.h"
+
+#include "brandeschoice.h"
+#include "shortestpathsearch.h"
+#include "taskscheduler.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <mutex>
+#include <random>
+
+namespace {
+    constexpr double INF = std::numeric_limits<double>::infinity();
+
+    // the sums over the origins of one stratum that the estimates and their
+    // variances are made of, per element
+    struct StratumSums {
+        std::vector<double> depth;
+        std::vector<double> depthSquared;
+        std::vector<double> reached;
+        std::vector<double> dependency;
+        std::vector<double> dependencySquared;
+
+        StratumSums(size_t numElements, bool withChoice)
+            : depth(numElements), depthSquared(numElements), reached(numElements),
+              dependency(withChoice ? numElements : 0),
+              dependencySquared(withChoice ? numElements : 0) {}
+
+        void add(const StratumSums &other) {
+            for (size_t i = 0; i < depth.size(); i++) {
+                depth[i] += other.depth[i];
+                depthSquared[i] += other.depthSquared[i];
+                reached[i] += other.reached[i];
+            }
+            for (size_t i = 0; i < dependency.size(); i++) {
+                dependency[i] += other.dependency[i];
+                dependencySquared[i] += other.dependencySquared[i];
+            }
+        }
+    };
+
+    // The weight of the sums over the origins of a stratum in the estimate
+    // of its total, and in the variance of that with the finite population
+    // correction. Nothing can be said of the variance from a single origin
+    struct StratumWeights {
+        double numOrigins;
+        double weight;
+        double varianceWeight;
+
+        StratumWeights(double stratumSize, double numOrigins_)
+            : numOrigins(numOrigins_), weight(numOrigins_ > 0 ? stratumSize / numOrigins_ : 0),
+              varianceWeight(numOrigins_ > 1 ? stratumSize * stratumSize *
+                                                   (1 - numOrigins_ / stratumSize) /
+                                                   (numOrigins_ * (numOrigins_ - 1))
+                                             : 0) {}
+    };
+
+    // uniform in [0, range) from the raw output of the generator, so that a
+    // seed picks the same on every platform, rejecting the few lowest values
+    // that would make the remainder favour the low numbers
+    uint32_t uniformBelow(std::mt19937 &generator, uint32_t range) {
+        uint32_t threshold = (0u - range) % range;
+        while (true) {
+            auto value = static_cast<uint32_t>(generator());
+            if (value >= threshold) {
+                return value % range;
+            }
+        }
+    }
+} // namespace
+
+namespace depthmapX {
+
+    OriginSample stratifiedSample(const std::vector<Point2f> &positions, double fraction,
+                                  uint32_t seed) {
+        OriginSample sample;
+        if (positions.empty()) {
+            return sample;
+        }
+        double minX = positions.front().x, maxX = minX;
+        double minY = positions.front().y, maxY = minY;
+        for (const auto &position : positions) {
+            minX = std::min(minX, position.x);
+            maxX = std::max(maxX, position.x);
+            minY = std::min(minY, position.y);
+            maxY = std::max(maxY, position.y);
+        }
+        auto cellIndex = [](double value, double min, double max) -> size_t {
+            if (max <= min) {
+                return 0;
+            }
+            auto index = static_cast<size_t>((value - min) / (max - min) *
+                                             static_cast<double>(SAMPLE_GRID_SIDE));
+            return std::min(index, SAMPLE_GRID_SIDE - 1);
+        };
+        sample.elementStrata.resize(positions.size());
+        std::vector<std::vector<size_t>> cells(SAMPLE_GRID_SIDE * SAMPLE_GRID_SIDE);
+        for (size_t i = 0; i < positions.size(); i++) {
+            cells[cellIndex(positions[i].y, minY, maxY) * SAMPLE_GRID_SIDE +
+                  cellIndex(positions[i].x, minX, maxX)]
+                .push_back(i);
+        }
+
+        std::mt19937 generator(seed);
+        for (auto &cell : cells) {
+            if (cell.empty()) {
+                continue;
+            }
+            for (size_t element : cell) {
+                sample.elementStrata[element] = sample.numStrata();
+            }
+            size_t size = cell.size();
+            auto numOrigins =
+                static_cast<size_t>(std::lround(fraction * static_cast<double>(size)));
+            numOrigins = std::min(std::max(numOrigins, std::min<size_t>(2, size)), size);
+            // the first numOrigins of a partial Fisher-Yates shuffle
+            for (size_t i = 0; i < numOrigins; i++) {
+                size_t pick = i + uniformBelow(generator, static_cast<uint32_t>(size - i));
+                std::swap(cell[i], cell[pick]);
+                sample.origins.push_back(cell[i]);
+            }
+            sample.strataStarts.push_back(sample.origins.size());
+            sample.strataSizes.push_back(size);
+        }
+        return sample;
+    }
+
+    CentralityEstimate estimateCentrality(const CsrGraph &graph, const CsrGraph &reverseGraph,
+                                          size_t nodesPerElement, const OriginSample &sample,
+                                          bool withChoice) {
+        size_t numElements = graph.numNodes() / nodesPerElement;
+        // Horvitz-Thompson totals with the variance of each stratum, the
+        // mean depth being the ratio of the depth and the reached totals
+        std::vector<double> totalDepth(numElements), totalReached(numElements);
+        std::vector<double> varDepth(numElements), varCross(numElements), varReached(numElements);
+        std::vector<double> totalChoice(withChoice ? numElements : 0);
+        std::vector<double> varChoice(withChoice ? numElements : 0);
+
+        auto &scheduler = TaskScheduler::global();
+        for (size_t h = 0; h < sample.numStrata(); h++) {
+            size_t begin = sample.strataStarts[h];
+            size_t end = sample.strataStarts[h + 1];
+            StratumSums sums(numElements, withChoice);
+            std::mutex sumsMutex;
+            size_t grainSize = (end - begin) / scheduler.numThreads() + 1;
+            scheduler.parallelFor(begin, end, grainSize, [&](size_t rangeBegin, size_t rangeEnd) {
+                StratumSums rangeSums(numElements, withChoice);
+                ShortestPathSearch search(graph, reverseGraph);
+                DependencySearch dependencySearch(graph, nodesPerElement);
+                std::vector<double> dependencies;
+                for (size_t s = rangeBegin; s < rangeEnd; s++) {
+                    size_t origin = sample.origins[s];
+                    std::vector<size_t> sources;
+                    for (size_t j = 0; j < nodesPerElement; j++) {
+                        sources.push_back(origin * nodesPerElement + j);
+                    }
+                    // to the origin from everywhere else
+                    auto distances = search.distancesFrom(sources, true);
+                    for (size_t element = 0; element < numElements; element++) {
+                        double depth = INF;
+                        for (size_t j = 0; j < nodesPerElement; j++) {
+                            depth = std::min(depth, distances[element * nodesPerElement + j]);
+                        }
+                        if (element != origin && depth != INF) {
+                            rangeSums.depth[element] += depth;
+                            rangeSums.depthSquared[element] += depth * depth;
+                            rangeSums.reached[element] += 1;
+                        }
+                    }
+                    if (withChoice) {
+                        dependencySearch.run(origin, dependencies);
+                        for (size_t element = 0; element < numElements; element++) {
+                            rangeSums.dependency[element] += dependencies[element];
+                            rangeSums.dependencySquared[element] +=
+                                dependencies[element] * dependencies[element];
+                        }
+                    }
+                }
+                std::lock_guard<std::mutex> lock(sumsMutex);
+                sums.add(rangeSums);
+            });
+
+            // An element only counts the other elements, so in its own
+            // stratum the origins are a sample of the others: all of them but
+            // itself if it is one of them, or else as many of one fewer
+            auto numOrigins = static_cast<double>(end - begin);
+            auto stratumSize = static_cast<double>(sample.strataSizes[h]);
+            const StratumWeights others(stratumSize, numOrigins);
+            const StratumWeights ownSampled(stratumSize - 1, numOrigins - 1);
+            const StratumWeights ownNotSampled(stratumSize - 1, numOrigins);
+            std::vector<char> sampled(numElements, 0);
+            for (size_t s = begin; s < end; s++) {
+                sampled[sample.origins[s]] = 1;
+            }
+            for (size_t i = 0; i < numElements; i++) {
+                const StratumWeights &w = sample.elementStrata[i] != h ? others
+                                          : sampled[i]                 ? ownSampled
+                                                                       : ownNotSampled;
+                if (w.numOrigins == 0) {
+                    continue;
+                }
+                totalDepth[i] += w.weight * sums.depth[i];
+                totalReached[i] += w.weight * sums.reached[i];
+                varDepth[i] += w.varianceWeight * (sums.depthSquared[i] -
+                                                   sums.depth[i] * sums.depth[i] / w.numOrigins);
+                varCross[i] += w.varianceWeight * (sums.depth[i] - sums.depth[i] *
+                                                                       sums.reached[i] /
+                                                                       w.numOrigins);
+                varReached[i] += w.varianceWeight * (sums.reached[i] - sums.reached[i] *
+                                                                           sums.reached[i] /
+                                                                           w.numOrigins);
+                if (withChoice) {
+                    totalChoice[i] += w.weight * sums.dependency[i];
+                    varChoice[i] +=
+                        w.varianceWeight * (sums.dependencySquared[i] -
+                                            sums.dependency[i] * sums.dependency[i] /
+                                                w.numOrigins);
+                }
+            }
+        }
+
+        const double z95 = 1.96;
+        CentralityEstimate estimate;
+        estimate.meanDepth.assign(numElements, -1);
+        estimate.meanDepthError.assign(numElements, -1);
+        estimate.nodeCount = totalReached;
+        for (size_t i = 0; i < numElements; i++) {
+            if (totalReached[i] > 0) {
+                double ratio = totalDepth[i] / totalReached[i];
+                // linearised variance of the ratio
+                double variance =
+                    varDepth[i] - 2 * ratio * varCross[i] + ratio * ratio * varReached[i];
+                estimate.meanDepth[i] = ratio;
+                estimate.meanDepthError[i] =
+                    z95 * std::sqrt(std::max(variance, 0.0)) / totalReached[i];
+            }
+        }
+        if (withChoice) {
+            estimate.choice = totalChoice;
+            for (double variance : varChoice) {
+                estimate.choiceError.push_back(z95 * std::sqrt(std::max(variance, 0.0)));
+            }
+        }
+        return estimate;
+    }
+
+    double integrationHH(double meanDepth, double numElements) {
+        if (numElements <= 2 || meanDepth <= 1) {
+            return -1;
+        }
+        double dValue = 2.0 * (numElements * (std::log2((numElements + 2.0) / 3.0) - 1.0) + 1.0) /
+                        ((numElements - 1.0) * (numElements - 2.0));
+        double relativeAsymmetry = 2.0 * (meanDepth - 1.0) / (numElements - 2.0);
+        return dValue / relativeAsymmetry;
+    }
+
+} // namespace depthmapX
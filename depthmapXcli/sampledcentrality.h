@@ -0,0 +1,66 @@
+// SPDX-FileCopyrightText: 2026 depthmapX authors
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#pragma once
+
+// Estimates of mean depth and choice from searches run from a sample of the
+// origins only, for exploring maps too large to analyse in full. Elements are
+// runs of consecutive nodes of the graph (one node per cell or axial line, two
+// per segment for its two directions), the depth of an element being that of
+// its nearest node. The sample is stratified over a grid of cells covering the
+// map, and every estimate comes with the half width of its 95% confidence
+// interval
+
+#include "csrgraph.h"
+
+#include "salalib/genlib/p2dpoly.h"
+
+#include <cstdint>
+#include <vector>
+
+namespace depthmapX {
+
+    // the strata of a sample are the cells of a grid of this many cells per
+    // side over the bounding box of the elements
+    static constexpr size_t SAMPLE_GRID_SIDE = 4;
+
+    struct OriginSample {
+        // grouped by stratum, the origins of stratum h being those from
+        // strataStarts[h] up to strataStarts[h + 1]
+        std::vector<size_t> origins;
+        std::vector<size_t> strataStarts = {0};
+        // number of elements in each stratum
+        std::vector<size_t> strataSizes;
+        // the stratum of each element
+        std::vector<size_t> elementStrata;
+
+        size_t numStrata() const { return strataSizes.size(); }
+    };
+
+    // The same fraction (0 to 1) of the elements of every stratum, but at
+    // least two where there are, as one origin tells nothing of the spread
+    OriginSample stratifiedSample(const std::vector<Point2f> &positions, double fraction,
+                                  uint32_t seed);
+
+    struct CentralityEstimate {
+        // mean depth to the other elements that can be reached and the
+        // number of them, -1 where no origin of the sample can be reached
+        std::vector<double> meanDepth;
+        std::vector<double> meanDepthError;
+        std::vector<double> nodeCount;
+        // only if asked for
+        std::vector<double> choice;
+        std::vector<double> choiceError;
+    };
+
+    // The searches are spread over the global task scheduler
+    CentralityEstimate estimateCentrality(const CsrGraph &graph, const CsrGraph &reverseGraph,
+                                          size_t nodesPerElement, const OriginSample &sample,
+                                          bool withChoice);
+
+    // Hillier and Hanson's integration from the mean depth and the number
+    // of elements (counting the element itself), -1 where not defined
+    double integrationHH(double meanDepth, double numElements);
+
+} // namespace depthmapX
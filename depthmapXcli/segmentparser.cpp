@@ -4,6 +4,7 @@
 
 #include "segmentparser.h"
 #include "exceptions.h"
+#include "graphbuilders.h"
 #include "parsingutils.h"
 #include "runmethods.h"
 #include "simpletimer.h"
@@ -16,7 +17,7 @@ using namespace depthmapX;
 
 SegmentParser::SegmentParser()
     : m_analysisType(InAnalysisType::NONE), m_radiusType(InRadiusType::NONE),
-      m_includeChoice(false), m_tulipBins(0) {}
+      m_includeChoice(false), m_brandesChoice(false), m_tulipBins(0) {}
 
 std::string SegmentParser::getModeName() const { return "SEGMENT"; }
 
@@ -33,6 +34,9 @@ std::string SegmentParser::getHelp() const {
            "       metric\n"
            "       angular\n"
            "  -sic to include choice (only for Tulip)\n"
+           "  -sicb to include choice computed in the cli by Brandes accumulation over all\n"
+           "       ordered pairs (only for Tulip at radius n, paths in the same bins share\n"
+           "       each pair), as T<bins> Choice [Brandes]\n"
            "  -stb <tulip bins> (4 to 1024, 1024 approximates full angular)\n"
            "  -swa <map attribute name> perform weighted analysis using this attribute (only for "
            "Tulip)\n";
@@ -74,6 +78,9 @@ void SegmentParser::parse(size_t argc, char **argv) {
             }
         } else if (std::strcmp(argv[i], "-sic") == 0) {
             m_includeChoice = true;
+        } else if (std::strcmp(argv[i], "-sicb") == 0) {
+            m_includeChoice = true;
+            m_brandesChoice = true;
         } else if (std::strcmp(argv[i], "-sr") == 0) {
             ENFORCE_ARGUMENT("-sr", i)
             m_radii = depthmapX::parseRadiusList(argv[i]);
@@ -114,7 +121,8 @@ void SegmentParser::parse(size_t argc, char **argv) {
 
     if (getAnalysisType() != InAnalysisType::ANGULAR_TULIP &&
         (getTulipBins() != 0 || getRadiusType() != InRadiusType::NONE || m_includeChoice)) {
-        throw CommandLineException("-stb, -srt and -sic can only be used with tulip analysis");
+        throw CommandLineException(
+            "-stb, -srt, -sic and -sicb can only be used with tulip analysis");
     }
 }
 
@@ -123,11 +131,16 @@ void SegmentParser::run(const CommandLineParser &clp, IPerformanceSink &perfWrit
 
     std::optional<std::string> mimicVersion = clp.getMimickVersion();
 
+    if (clp.getSampleFraction() > 0 && getAnalysisType() != InAnalysisType::ANGULAR_TULIP) {
+        throw depthmapX::RuntimeException("Sampled segment analysis (-sa) requires tulip analysis");
+    }
+
     std::cout << "Running segment analysis... " << std::flush;
     Options options;
     const std::vector<double> &radii = getRadii();
     options.radiusSet.insert(radii.begin(), radii.end());
-    options.choice = includeChoice();
+    // with -sicb choice is accumulated here instead of by salalib
+    options.choice = includeChoice() && !brandesChoice();
     options.tulipBins = getTulipBins();
     options.weightedMeasureCol = -1;
 
@@ -163,10 +176,43 @@ void SegmentParser::run(const CommandLineParser &clp, IPerformanceSink &perfWrit
     }
     switch (getAnalysisType()) {
     case InAnalysisType::ANGULAR_TULIP: {
+        if (clp.getSampleFraction() > 0) {
+            if (getRadii() != std::vector<double>{-1.0} || options.weightedMeasureCol != -1) {
+                throw depthmapX::RuntimeException(
+                    "Sampled tulip analysis (-sa) requires radius n without -swa");
+            }
+            auto &map = metaGraph.getDisplayedShapeGraph();
+            std::vector<int> shapeRefs;
+            std::vector<Point2f> midpoints;
+            auto graph = dm_graphbuilders::segmentGraph(
+                map.getInternalMap(), dm_graphbuilders::SegmentCost::ANGULAR, shapeRefs,
+                &midpoints, getTulipBins());
+            // a bin is 4 / bins of the depth of a right angle turn
+            dm_runmethods::runSampledCentrality(clp, perfWriter, graph, 2, midpoints, shapeRefs,
+                                                includeChoice(), false,
+                                                "T" + std::to_string(getTulipBins()) + " ",
+                                                map.getAttributeTable(), 4.0 / getTulipBins());
+            break;
+        }
+        if (brandesChoice() &&
+            (getRadii() != std::vector<double>{-1.0} || options.weightedMeasureCol != -1)) {
+            throw depthmapX::RuntimeException("-sicb requires radius n without -swa");
+        }
         DO_TIMED("Segment tulip analysis",
                  metaGraph.analyseSegmentsTulip(
                      dm_runmethods::getCommunicator(clp).get(), options,
                      (mimicVersion.has_value() && mimicVersion == "depthmapX 0.8.0")))
+        if (brandesChoice()) {
+            auto &map = metaGraph.getDisplayedShapeGraph();
+            std::vector<int> shapeRefs;
+            auto graph = dm_graphbuilders::segmentGraph(map.getInternalMap(),
+                                                        dm_graphbuilders::SegmentCost::ANGULAR,
+                                                        shapeRefs, nullptr, getTulipBins());
+            dm_runmethods::runBrandesChoice(perfWriter, graph, 2, shapeRefs,
+                                            "T" + std::to_string(getTulipBins()) +
+                                                " Choice [Brandes]",
+                                            map.getAttributeTable());
+        }
         break;
     }
     case InAnalysisType::ANGULAR_FULL: {
@@ -27,6 +27,8 @@ class SegmentParser : public IModeParser {
 
     bool includeChoice() const { return m_includeChoice; }
 
+    bool brandesChoice() const { return m_brandesChoice; }
+
     int getTulipBins() const { return m_tulipBins; }
 
     const std::vector<double> getRadii() const { return m_radii; }
@@ -37,6 +39,7 @@ class SegmentParser : public IModeParser {
     InAnalysisType m_analysisType;
     InRadiusType m_radiusType;
     bool m_includeChoice;
+    bool m_brandesChoice;
     int m_tulipBins;
     std::vector<double> m_radii;
     std::string m_attribute;
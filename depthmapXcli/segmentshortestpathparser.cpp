@@ -4,21 +4,237 @@
 
 #include "segmentshortestpathparser.h"
 
+#include "cancellationtoken.h"
+#include "checkpoint.h"
+#include "contractionhierarchy.h"
 #include "exceptions.h"
+#include "graphbuilders.h"
+#include "graphdiff.h"
 #include "parsingutils.h"
 #include "runmethods.h"
+#include "shortestpathsearch.h"
 #include "simpletimer.h"
+#include "taskscheduler.h"
 
 #include "salalib/entityparsing.h"
 #include "salalib/segmmodules/segmmetricshortestpath.h"
 #include "salalib/segmmodules/segmtopologicalshortestpath.h"
 #include "salalib/segmmodules/segmtulipshortestpath.h"
 
+#include <algorithm>
+#include <cctype>
+#include <cmath>
+#include <cstdio>
 #include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <limits>
+#include <map>
+#include <optional>
 #include <sstream>
+#include <unordered_map>
+#include <unordered_set>
 
 using namespace depthmapX;
 
+namespace {
+    struct PreviousResult {
+        // as written, so that a reused result is output the same
+        std::string text;
+        double distance;
+        std::vector<int> path;
+    };
+
+    std::vector<std::string> splitCsvLine(const std::string &line) {
+        std::vector<std::string> fields;
+        std::stringstream lineStream(line);
+        std::string field;
+        while (std::getline(lineStream, field, ',')) {
+            fields.push_back(field);
+        }
+        if (!line.empty() && line.back() == ',') {
+            fields.emplace_back();
+        }
+        return fields;
+    }
+
+    // the distance column of an od csv names the step type, so that the
+    // results of one type are not reused for another
+    std::string distanceColumnName(const std::string &stepTypeName) {
+        return static_cast<char>(std::toupper(static_cast<unsigned char>(stepTypeName[0]))) +
+               stepTypeName.substr(1) + " Distance";
+    }
+
+    // The finished pairs of an od csv written with paths, by their refs.
+    // Unreachable destinations are at infinity. Throws if the csv is not of
+    // the given step type
+    std::map<std::pair<int, int>, PreviousResult>
+    readPreviousResults(const std::string &filename, const std::string &stepTypeName) {
+        std::ifstream stream(filename);
+        if (!stream) {
+            std::stringstream message;
+            message << "Failed to load file " << filename << ", error " << std::strerror(errno)
+                    << std::flush;
+            throw depthmapX::RuntimeException(message.str().c_str());
+        }
+        std::string line;
+        std::getline(stream, line);
+        auto header = splitCsvLine(line);
+        auto column = [&header](const std::string &name) -> std::optional<size_t> {
+            auto iter = std::find(header.begin(), header.end(), name);
+            if (iter == header.end()) {
+                return std::nullopt;
+            }
+            return static_cast<size_t>(iter - header.begin());
+        };
+        auto originColumn = column("Origin Ref");
+        auto destinationColumn = column("Destination Ref");
+        auto distanceColumn = column(distanceColumnName(stepTypeName));
+        auto pathColumn = column("Path");
+        auto finishedColumn = column("Finished");
+        if (!originColumn || !destinationColumn || !pathColumn) {
+            throw depthmapX::RuntimeException(filename +
+                                              " is not an od csv with paths (written with -sspp)");
+        }
+        if (!distanceColumn) {
+            throw depthmapX::RuntimeException(filename + " was not calculated with " +
+                                              stepTypeName + " steps");
+        }
+
+        std::map<std::pair<int, int>, PreviousResult> results;
+        while (std::getline(stream, line)) {
+            if (line.empty()) {
+                continue;
+            }
+            auto fields = splitCsvLine(line);
+            if (fields.size() != header.size()) {
+                throw depthmapX::RuntimeException("Invalid line in " + filename + ": " + line);
+            }
+            if (finishedColumn && fields[*finishedColumn] != "1") {
+                continue;
+            }
+            try {
+                PreviousResult result;
+                result.text = fields[*distanceColumn] + "," + fields[*pathColumn];
+                result.distance = std::stod(fields[*distanceColumn]);
+                if (result.distance < 0) {
+                    result.distance = std::numeric_limits<double>::infinity();
+                }
+                std::stringstream pathStream(fields[*pathColumn]);
+                int ref;
+                while (pathStream >> ref) {
+                    result.path.push_back(ref);
+                }
+                results[{std::stoi(fields[*originColumn]), std::stoi(fields[*destinationColumn])}] =
+                    std::move(result);
+            } catch (const std::logic_error &) {
+                throw depthmapX::RuntimeException("Invalid line in " + filename + ": " + line);
+            }
+        }
+        return results;
+    }
+
+    // segment nodes matched between versions of a map by ref and direction
+    std::vector<int64_t> segmentNodeKeys(const std::vector<int> &shapeRefs) {
+        std::vector<int64_t> keys;
+        for (int ref : shapeRefs) {
+            keys.push_back(2 * static_cast<int64_t>(ref));
+            keys.push_back(2 * static_cast<int64_t>(ref) + 1);
+        }
+        return keys;
+    }
+
+    // Marks the pairs whose path in the previous results the edits from the
+    // base graph can not have changed as finished, returning how many
+    size_t reusePreviousResults(const std::string &previousResultsFile,
+                                const std::string &baseGraphFile, const CsrGraph &graph,
+                                const std::vector<int> &shapeRefs,
+                                const std::vector<std::pair<size_t, size_t>> &odPairs,
+                                dm_graphbuilders::SegmentCost cost,
+                                const std::string &stepTypeName, Checkpoint &checkpoint,
+                                IPerformanceSink &perfWriter) {
+        // read first, to fail before the base graph is loaded
+        auto previousResults = readPreviousResults(previousResultsFile, stepTypeName);
+        auto baseGraph = dm_runmethods::loadGraph(baseGraphFile, perfWriter);
+        auto &baseMap = baseGraph.getDisplayedShapeGraph();
+        if (baseMap.getMapType() != ShapeMap::SEGMENTMAP) {
+            throw depthmapX::RuntimeException("The base graph of -sspib requires a segment map");
+        }
+        std::vector<int> baseShapeRefs;
+        auto baseSegmentGraph = dm_graphbuilders::segmentGraph(baseMap.getInternalMap(), cost,
+                                                               baseShapeRefs);
+
+        auto keys = segmentNodeKeys(shapeRefs);
+        auto changed = changedNodes(baseSegmentGraph, segmentNodeKeys(baseShapeRefs),
+                                               graph, keys);
+        // refs a previous path can not go through any more, removed or with a
+        // changed node in either direction
+        std::unordered_set<int> brokenRefs(baseShapeRefs.begin(), baseShapeRefs.end());
+        for (int ref : shapeRefs) {
+            brokenRefs.erase(ref);
+        }
+        for (size_t node : changed) {
+            brokenRefs.insert(shapeRefs[dm_graphbuilders::nodeSegment(node)]);
+        }
+        std::cout << changed.size() << " of " << graph.numNodes() << " segment nodes changed... "
+                  << std::flush;
+
+        std::vector<std::pair<size_t, const PreviousResult *>> candidates;
+        for (size_t i = 0; i < odPairs.size(); i++) {
+            if (checkpoint.isFinished(i)) {
+                continue;
+            }
+            auto previous = previousResults.find(
+                {shapeRefs[odPairs[i].first], shapeRefs[odPairs[i].second]});
+            if (previous == previousResults.end() ||
+                std::any_of(previous->second.path.begin(), previous->second.path.end(),
+                            [&brokenRefs](int ref) { return brokenRefs.count(ref) != 0; })) {
+                continue;
+            }
+            candidates.push_back({i, &previous->second});
+        }
+        // bounding costs two full searches per changed node, more than
+        // recalculating the pairs if the edits are widespread, so with more
+        // changed nodes than half the candidate pairs everything is
+        // recalculated (as the help of -sspi says)
+        if (changed.size() * 2 > candidates.size()) {
+            return 0;
+        }
+
+        // a pair keeps its path if every new path leaving a changed node is at
+        // least as long. The tolerance covers the rounding of the csv
+        std::unordered_map<size_t, size_t> originGroups;
+        std::unordered_map<size_t, size_t> destinationGroups;
+        std::vector<std::vector<size_t>> sourceGroups;
+        std::vector<std::vector<size_t>> targetGroups;
+        for (const auto &candidate : candidates) {
+            size_t origin = odPairs[candidate.first].first;
+            size_t destination = odPairs[candidate.first].second;
+            if (originGroups.emplace(origin, sourceGroups.size()).second) {
+                sourceGroups.push_back({dm_graphbuilders::segmentNode(origin, true),
+                                        dm_graphbuilders::segmentNode(origin, false)});
+            }
+            if (destinationGroups.emplace(destination, targetGroups.size()).second) {
+                targetGroups.push_back({dm_graphbuilders::segmentNode(destination, true),
+                                        dm_graphbuilders::segmentNode(destination, false)});
+            }
+        }
+        auto reverseGraph = graph.reversed();
+        ChangedPathBounds bounds(graph, reverseGraph, changed, sourceGroups, targetGroups);
+        size_t numReused = 0;
+        for (const auto &candidate : candidates) {
+            double distance = candidate.second->distance;
+            double bound = bounds.bound(originGroups[odPairs[candidate.first].first],
+                                        destinationGroups[odPairs[candidate.first].second]);
+            if (bound >= distance + std::abs(distance) * 1e-5) {
+                checkpoint.finish(candidate.first, candidate.second->text);
+                numReused++;
+            }
+        }
+        return numReused;
+    }
+} // namespace
+
 void SegmentShortestPathParser::parse(size_t argc, char **argv) {
 
     std::string originPoint;
@@ -60,9 +276,67 @@ void SegmentShortestPathParser::parse(size_t argc, char **argv) {
             } else {
                 throw CommandLineException(std::string("Invalid step type: ") + argv[i]);
             }
+        } else if (std::strcmp("-sspf", argv[i]) == 0) {
+            ENFORCE_ARGUMENT("-sspf", i)
+            m_odFile = argv[i];
+        } else if (std::strcmp("-sspr", argv[i]) == 0) {
+            m_odRefs = true;
+        } else if (std::strcmp("-sspa", argv[i]) == 0) {
+            m_aStar = true;
+        } else if (std::strcmp("-sspp", argv[i]) == 0) {
+            m_outputPaths = true;
+        } else if (std::strcmp("-sspc", argv[i]) == 0) {
+            m_useHierarchy = true;
+        } else if (std::strcmp("-sspi", argv[i]) == 0) {
+            ENFORCE_ARGUMENT("-sspi", i)
+            m_previousResultsFile = argv[i];
+        } else if (std::strcmp("-sspib", argv[i]) == 0) {
+            ENFORCE_ARGUMENT("-sspib", i)
+            m_baseGraphFile = argv[i];
         }
     }
 
+    if (!m_odFile.empty()) {
+        if (!originPoint.empty() || !destinationPoint.empty()) {
+            throw CommandLineException("-sspf cannot be used together with -sspo or -sspd");
+        }
+        if (m_stepType == StepType::NONE) {
+            throw CommandLineException("Step depth type (-sspt) must be provided");
+        }
+        if (m_aStar && m_stepType != StepType::METRIC) {
+            throw CommandLineException("-sspa can only be used with metric shortest paths");
+        }
+        if (m_aStar && m_useHierarchy) {
+            throw CommandLineException("-sspa cannot be used together with -sspc");
+        }
+        if (m_previousResultsFile.empty() != m_baseGraphFile.empty()) {
+            throw CommandLineException("-sspi and -sspib must be provided together");
+        }
+        if (!m_previousResultsFile.empty() && !m_outputPaths) {
+            throw CommandLineException("-sspi can only be used with -sspp");
+        }
+        std::ifstream odStream(m_odFile);
+        if (!odStream) {
+            std::stringstream message;
+            message << "Failed to load file " << m_odFile << ", error " << std::strerror(errno)
+                    << std::flush;
+            throw depthmapX::RuntimeException(message.str().c_str());
+        }
+        if (m_odRefs) {
+            m_odRefPairs = EntityParsing::parseRefPairs(odStream, '\t');
+        } else {
+            m_odLines = EntityParsing::parseLines(odStream, '\t');
+        }
+        return;
+    }
+
+    if (m_odRefs || m_aStar || m_outputPaths || m_useHierarchy) {
+        throw CommandLineException("-sspr, -sspa, -sspp and -sspc can only be used with -sspf");
+    }
+    if (!m_previousResultsFile.empty() || !m_baseGraphFile.empty()) {
+        throw CommandLineException("-sspi and -sspib can only be used with -sspf");
+    }
+
     if (originPoint.empty() || destinationPoint.empty()) {
         throw CommandLineException("Both -sspo and -sspd must be provided");
     }
@@ -82,6 +356,11 @@ void SegmentShortestPathParser::parse(size_t argc, char **argv) {
 
 void SegmentShortestPathParser::run(const CommandLineParser &clp,
                                     IPerformanceSink &perfWriter) const {
+    if (isODMatrix()) {
+        runODMatrix(clp, perfWriter);
+        return;
+    }
+
     auto metaGraph = dm_runmethods::loadGraph(clp.getFileName().c_str(), perfWriter);
 
     std::optional<std::string> mimicVersion = clp.getMimickVersion();
@@ -162,3 +441,270 @@ void SegmentShortestPathParser::run(const CommandLineParser &clp,
              dm_runmethods::writeGraph(clp, metaGraph, clp.getOuputFile().c_str(), false))
     std::cout << " ok" << std::endl;
 }
+
+void SegmentShortestPathParser::runODMatrix(const CommandLineParser &clp,
+                                            IPerformanceSink &perfWriter) const {
+    auto metaGraph = dm_runmethods::loadGraph(clp.getFileName().c_str(), perfWriter);
+
+    auto &map = metaGraph.getDisplayedShapeGraph();
+    if (map.getMapType() != ShapeMap::SEGMENTMAP) {
+        throw depthmapX::RuntimeException("OD shortest paths require a segment map");
+    }
+
+    dm_graphbuilders::SegmentCost cost = dm_graphbuilders::SegmentCost::METRIC;
+    std::string stepTypeName;
+    switch (m_stepType) {
+    case SegmentShortestPathParser::StepType::TULIP:
+        cost = dm_graphbuilders::SegmentCost::ANGULAR;
+        stepTypeName = "tulip";
+        break;
+    case SegmentShortestPathParser::StepType::METRIC:
+        cost = dm_graphbuilders::SegmentCost::METRIC;
+        stepTypeName = "metric";
+        break;
+    case SegmentShortestPathParser::StepType::TOPOLOGICAL:
+        cost = dm_graphbuilders::SegmentCost::TOPOLOGICAL;
+        stepTypeName = "topological";
+        break;
+    default: {
+        throw depthmapX::SetupCheckException("Error, unsupported step type");
+    }
+    }
+
+    std::cout << "Building segment graph... " << std::flush;
+    std::vector<int> shapeRefs;
+    std::vector<Point2f> midpoints;
+    depthmapX::CsrGraph graph;
+    DO_TIMED("Building segment graph",
+             graph = dm_graphbuilders::segmentGraph(map.getInternalMap(), cost, shapeRefs,
+                                                    &midpoints))
+    depthmapX::CsrGraph reverseGraph;
+    depthmapX::ContractionHierarchy hierarchy;
+    if (m_useHierarchy) {
+        std::string hierarchyFile = clp.getFileName() + "." + stepTypeName + ".ch";
+        std::ifstream hierarchyInStream(hierarchyFile, std::ios::binary);
+        std::cout << "ok\nLoading contraction hierarchy... " << std::flush;
+        bool loaded = false;
+        DO_TIMED("Loading contraction hierarchy",
+                 loaded = hierarchyInStream && hierarchy.read(hierarchyInStream, graph))
+        if (!loaded) {
+            std::cout << "not found or out of date\nBuilding contraction hierarchy... "
+                      << std::flush;
+            DO_TIMED("Building contraction hierarchy",
+                     hierarchy = depthmapX::ContractionHierarchy::build(graph))
+            hierarchy.writeFile(hierarchyFile);
+        }
+    } else {
+        reverseGraph = graph.reversed();
+    }
+
+    std::unordered_map<int, size_t> segmentIndices;
+    for (size_t i = 0; i < shapeRefs.size(); i++) {
+        segmentIndices[shapeRefs[i]] = i;
+    }
+    auto segmentFromRef = [&segmentIndices](int ref) -> size_t {
+        auto indexIter = segmentIndices.find(ref);
+        if (indexIter == segmentIndices.end()) {
+            throw depthmapX::RuntimeException("Segment ref " + std::to_string(ref) +
+                                              " does not exist in the segment map");
+        }
+        return indexIter->second;
+    };
+    auto segmentAtPoint = [&map, &segmentFromRef](const Point2f &point) -> size_t {
+        auto shapes = map.getInternalMap().getShapesInRegion(QtRegion(point, point));
+        if (shapes.empty()) {
+            std::stringstream message;
+            message << "No segment found at " << point.x << "," << point.y << std::flush;
+            throw depthmapX::RuntimeException(message.str());
+        }
+        return segmentFromRef(shapes.begin()->first);
+    };
+
+    std::vector<std::pair<size_t, size_t>> odPairs;
+    for (const auto &refPair : m_odRefPairs) {
+        odPairs.push_back({segmentFromRef(refPair.first), segmentFromRef(refPair.second)});
+    }
+    for (const auto &line : m_odLines) {
+        odPairs.push_back({segmentAtPoint(line.start()), segmentAtPoint(line.end())});
+    }
+    if (clp.getOriginRange()) {
+        // a shard only calculates the pairs of its range
+        size_t endPair = std::min(clp.getOriginRange()->second, odPairs.size());
+        odPairs.erase(odPairs.begin() + static_cast<long>(endPair), odPairs.end());
+        odPairs.erase(odPairs.begin(),
+                      odPairs.begin() +
+                          static_cast<long>(std::min(clp.getOriginRange()->first, endPair)));
+    }
+    if (auto regionOfInterest = dm_runmethods::loadRegionOfInterest(clp)) {
+        // only the pairs starting in the region, the paths may leave it
+        size_t numPairs = odPairs.size();
+        odPairs.erase(std::remove_if(odPairs.begin(), odPairs.end(),
+                                     [&](const std::pair<size_t, size_t> &odPair) {
+                                         return !regionOfInterest->contains(
+                                             midpoints[odPair.first]);
+                                     }),
+                      odPairs.end());
+        std::cout << "ok\n"
+                  << odPairs.size() << " of " << numPairs
+                  << " pairs start in the region of interest... " << std::flush;
+    }
+
+    // the results of each pair are kept as text, the distance followed by
+    // the path if asked for, so that they can be checkpointed and resumed
+    std::stringstream checkpointKey;
+    checkpointKey << "od " << stepTypeName << " " << m_aStar << m_useHierarchy << m_outputPaths
+                  << " " << depthmapX::graphFingerprint(graph);
+    for (const auto &odPair : odPairs) {
+        checkpointKey << " " << shapeRefs[odPair.first] << "," << shapeRefs[odPair.second];
+    }
+    depthmapX::Checkpoint checkpoint(checkpointKey.str(), odPairs.size());
+    if (!clp.getResumeFile().empty()) {
+        std::cout << "ok\nResuming from " << clp.getResumeFile() << "... " << std::flush;
+        checkpoint.resume(clp.getResumeFile());
+        std::cout << checkpoint.numFinished() << " of " << odPairs.size() << " pairs done"
+                  << std::flush;
+    }
+    if (isIncremental()) {
+        std::cout << "\nReusing the paths of " << m_previousResultsFile << "... " << std::flush;
+        SimpleTimer ti;
+        size_t numReused = reusePreviousResults(m_previousResultsFile, m_baseGraphFile, graph,
+                                                shapeRefs, odPairs, cost, stepTypeName, checkpoint,
+                                                perfWriter);
+        perfWriter.addData("Reusing previous od shortest paths", ti.getTimeInSeconds());
+        std::cout << numReused << " pairs reused" << std::flush;
+    }
+    std::string checkpointFile;
+    if (clp.getCheckpointInterval() > 0) {
+        checkpointFile = clp.getOuputFile() + ".checkpoint";
+    }
+
+    std::vector<size_t> pending;
+    for (size_t i = 0; i < odPairs.size(); i++) {
+        if (!checkpoint.isFinished(i)) {
+            pending.push_back(i);
+        }
+    }
+
+    std::cout << "\nCalculating " << pending.size() << " shortest paths... " << std::flush;
+    // pairs not reached before the time budget ran out stay unfinished
+    const auto &token = depthmapX::CancellationToken::global();
+    SimpleTimer t;
+    {
+        // a few ranges per thread, as each range sets up its own search. With
+        // checkpoints the pairs are taken in rounds, and a checkpoint is
+        // written after a round once the interval has passed
+        auto &scheduler = depthmapX::TaskScheduler::global();
+        size_t grainSize = pending.size() / (4 * scheduler.numThreads()) + 1;
+        size_t roundSize = pending.size();
+        if (!checkpointFile.empty()) {
+            grainSize = std::min<size_t>(grainSize, 64);
+            roundSize = grainSize * 4 * scheduler.numThreads();
+        }
+        auto body = [&](size_t begin, size_t end) {
+            std::optional<depthmapX::ShortestPathSearch> search;
+            std::optional<depthmapX::ContractionHierarchyQuery> hierarchyQuery;
+            if (m_useHierarchy) {
+                hierarchyQuery.emplace(hierarchy);
+            } else {
+                search.emplace(graph, reverseGraph);
+            }
+            for (size_t p = begin; p < end && !token.isCancelled(); p++) {
+                size_t i = pending[p];
+                size_t origin = odPairs[i].first;
+                size_t destination = odPairs[i].second;
+                std::vector<size_t> sources{dm_graphbuilders::segmentNode(origin, true),
+                                            dm_graphbuilders::segmentNode(origin, false)};
+                std::vector<size_t> targets{dm_graphbuilders::segmentNode(destination, true),
+                                            dm_graphbuilders::segmentNode(destination, false)};
+                depthmapX::PathResult result;
+                if (m_useHierarchy) {
+                    result = hierarchyQuery->query(sources, targets, m_outputPaths);
+                } else if (m_aStar) {
+                    const Point2f &goal = midpoints[destination];
+                    result = search->aStar(
+                        sources, targets,
+                        [&midpoints, &goal](size_t node) -> double {
+                            return dist(midpoints[dm_graphbuilders::nodeSegment(node)], goal);
+                        },
+                        m_outputPaths);
+                } else {
+                    result = search->bidirectional(sources, targets, m_outputPaths);
+                }
+                // at full precision, as the distances are read back to
+                // reuse them
+                std::stringstream text;
+                text << std::setprecision(std::numeric_limits<double>::max_digits10)
+                     << result.distance;
+                if (m_outputPaths) {
+                    text << ",";
+                    for (size_t n = 0; n < result.nodes.size(); n++) {
+                        text << (n == 0 ? "" : " ")
+                             << shapeRefs[dm_graphbuilders::nodeSegment(result.nodes[n])];
+                    }
+                }
+                checkpoint.finish(i, text.str());
+            }
+        };
+        SimpleTimer sinceCheckpoint;
+        for (size_t roundBegin = 0; roundBegin < pending.size() && !token.isCancelled();
+             roundBegin += roundSize) {
+            scheduler.parallelFor(roundBegin, std::min(roundBegin + roundSize, pending.size()),
+                                  grainSize, body);
+            if (!checkpointFile.empty() &&
+                sinceCheckpoint.getTimeInSeconds() >=
+                    static_cast<double>(clp.getCheckpointInterval())) {
+                checkpoint.write(checkpointFile);
+                sinceCheckpoint.reset();
+            }
+        }
+    }
+    perfWriter.addData("Calculating od shortest paths", t.getTimeInSeconds());
+    size_t numFinished = checkpoint.numFinished();
+    if (numFinished < odPairs.size()) {
+        std::cout << "time budget ran out after " << numFinished << " of " << odPairs.size()
+                  << " pairs... " << std::flush;
+    }
+    if (!checkpointFile.empty()) {
+        // kept for resuming if unfinished, and replaced by the output otherwise
+        if (numFinished < odPairs.size()) {
+            checkpoint.write(checkpointFile);
+        } else {
+            std::remove(checkpointFile.c_str());
+        }
+    }
+
+    std::cout << "ok\nWriting out result..." << std::flush;
+    SimpleTimer tw;
+    std::ofstream outStream(clp.getOuputFile().c_str());
+    // with a time budget the pairs may not all be calculated, which the
+    // Finished column tells apart from unreachable destinations
+    bool budgeted = clp.getTimeBudget() > 0;
+    outStream << "Origin Ref,Destination Ref," << distanceColumnName(stepTypeName);
+    if (budgeted) {
+        outStream << ",Finished";
+    }
+    if (m_outputPaths) {
+        outStream << ",Path";
+    }
+    outStream << "\n";
+    const std::string unfinished = "-1";
+    for (size_t i = 0; i < odPairs.size(); i++) {
+        outStream << shapeRefs[odPairs[i].first] << "," << shapeRefs[odPairs[i].second] << ",";
+        const std::string &result = checkpoint.isFinished(i) ? checkpoint.result(i) : unfinished;
+        size_t pathStart = result.find(',');
+        outStream << result.substr(0, pathStart);
+        if (budgeted) {
+            outStream << "," << (checkpoint.isFinished(i) ? 1 : 0);
+        }
+        if (m_outputPaths) {
+            outStream << ",";
+            if (pathStart != std::string::npos) {
+                outStream << result.substr(pathStart + 1);
+            }
+        }
+        outStream << "\n";
+    }
+    outStream << std::flush;
+    perfWriter.addData("Writing od shortest paths", tw.getTimeInSeconds());
+    std::cout << " ok" << std::endl;
+}
@@ -8,11 +8,14 @@
 
 #include "salalib/genlib/p2dpoly.h"
 
+#include <string>
 #include <vector>
 
 class SegmentShortestPathParser : public IModeParser {
   public:
-    SegmentShortestPathParser() : m_stepType(StepType::NONE) {}
+    SegmentShortestPathParser()
+        : m_stepType(StepType::NONE), m_odRefs(false), m_aStar(false), m_outputPaths(false),
+          m_useHierarchy(false) {}
 
     std::string getModeName() const override { return "SEGMENTSHORTESTPATH"; }
 
@@ -22,7 +25,26 @@ class SegmentShortestPathParser : public IModeParser {
                "between.\n"
                "  -sspd <shortest path destination point> point where to calculate shortest path "
                "between.\n"
-               "  -sspt <type> step type. One of metric, tulip or topological.\n";
+               "  -sspt <type> step type. One of metric, tulip or topological.\n"
+               "  -sspf <od file> calculate the shortest paths between many origin-destination\n"
+               "        pairs instead of a single one, writing them to the output file as csv.\n"
+               "        The file is tab-separated with columns x1, y1 (origin) and x2, y2\n"
+               "        (destination). Tulip distances use the exact angle of each turn and\n"
+               "        topological distances count the turns. The distance column is named\n"
+               "        by the step type\n"
+               "  -sspr the od file contains segment refs (columns reffrom and refto) instead\n"
+               "        of coordinates\n"
+               "  -sspa use A* guided search for metric od paths instead of bidirectional search\n"
+               "  -sspp include the segments of each od path in the output\n"
+               "  -sspc answer od paths from a contraction hierarchy of the segment graph. The\n"
+               "        hierarchy is saved next to the graph file as <graph file>.<type>.ch and\n"
+               "        rebuilt only if missing or the segment map has changed\n"
+               "  -sspi <previous od csv> reuse the paths of a previous run (written with -sspp)\n"
+               "        that the edits since can not have changed, recalculating the rest. Needs\n"
+               "        -sspp, the same step type and the graph the previous run was on given\n"
+               "        with -sspib. If more segment directions changed than half the pairs that\n"
+               "        could be reused, all are recalculated as that is quicker\n"
+               "  -sspib <base graph> the graph file the previous od csv was calculated on\n";
     }
 
     enum class StepType { NONE, TULIP, METRIC, TOPOLOGICAL };
@@ -36,9 +58,31 @@ class SegmentShortestPathParser : public IModeParser {
 
     StepType getStepType() const { return m_stepType; }
 
+    bool isODMatrix() const { return !m_odFile.empty(); }
+    const std::vector<Line> &getODLines() const { return m_odLines; }
+    const std::vector<std::pair<int, int>> &getODRefPairs() const { return m_odRefPairs; }
+    bool useAStar() const { return m_aStar; }
+    bool outputPaths() const { return m_outputPaths; }
+    bool useHierarchy() const { return m_useHierarchy; }
+    bool isIncremental() const { return !m_previousResultsFile.empty(); }
+    const std::string &getPreviousResultsFile() const { return m_previousResultsFile; }
+    const std::string &getBaseGraphFile() const { return m_baseGraphFile; }
+
   private:
+    void runODMatrix(const CommandLineParser &clp, IPerformanceSink &perfWriter) const;
+
     Point2f m_originPoint;
     Point2f m_destinationPoint;
 
     StepType m_stepType;
+
+    std::string m_odFile;
+    bool m_odRefs;
+    bool m_aStar;
+    bool m_outputPaths;
+    bool m_useHierarchy;
+    std::vector<Line> m_odLines;
+    std::vector<std::pair<int, int>> m_odRefPairs;
+    std::string m_previousResultsFile;
+    std::string m_baseGraphFile;
 };
@@ -0,0 +1,194 @@
+// SPDX-FileCopyrightText: 2026 depthmapX authors
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "server.h"
+
+#include "commandlineparser.h"
+#include "exceptions.h"
+#include "graphcache.h"
+#include "performancewriter.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <iostream>
+
+#ifndef _WIN32
+#include <csignal>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/time.h>
+#include <sys/un.h>
+#include <unistd.h>
+#endif
+
+namespace {
+#ifndef _WIN32
+    // false if the connection is closed or the line is not complete by the
+    // deadline. The connection has a receive timeout, so that each read
+    // returns by then
+    bool readLine(int connection, std::string &line,
+                  std::chrono::steady_clock::time_point deadline) {
+        char buffer[4096];
+        while (std::chrono::steady_clock::now() < deadline) {
+            ssize_t received = read(connection, buffer, sizeof(buffer));
+            if (received < 0 && errno == EINTR) {
+                continue;
+            }
+            if (received <= 0) {
+                return false;
+            }
+            line.append(buffer, static_cast<size_t>(received));
+            size_t end = line.find('\n');
+            if (end != std::string::npos) {
+                line.erase(end);
+                if (!line.empty() && line.back() == '\r') {
+                    line.pop_back();
+                }
+                return true;
+            }
+        }
+        return false;
+    }
+#endif
+
+    // runs one request with its output going to std::cout, returning the
+    // exit status of the forked process
+    int runRequest(const std::vector<std::string> &arguments,
+                   const IModeParserFactory &parserFactory) {
+        std::vector<std::string> argumentCopies{"depthmapXcli"};
+        argumentCopies.insert(argumentCopies.end(), arguments.begin(), arguments.end());
+        std::vector<char *> argv;
+        for (auto &argument : argumentCopies) {
+            argv.push_back(&argument[0]);
+        }
+        try {
+            CommandLineParser clp(parserFactory);
+            clp.parse(argv.size(), argv.data());
+            if (!clp.isValid()) {
+                throw depthmapX::CommandLineException(
+                    "Requests must give a mode, an input and an output file");
+            }
+            PerformanceWriter perfWriter(clp.getTimingFile());
+            clp.run(perfWriter);
+            perfWriter.write();
+            std::cout << "OK " << clp.getOuputFile() << std::endl;
+            return 0;
+        } catch (std::exception &e) {
+            std::cout << "\nERROR " << e.what() << std::endl;
+        } catch (...) {
+            std::cout << "\nERROR Analysis stopped" << std::endl;
+        }
+        return 1;
+    }
+} // namespace
+
+namespace dm_server {
+
+    std::vector<std::string> splitRequest(const std::string &line) {
+        std::vector<std::string> arguments;
+        size_t start = 0;
+        while (start <= line.size()) {
+            size_t end = std::min(line.find('\t', start), line.size());
+            if (end > start) {
+                arguments.push_back(line.substr(start, end - start));
+            }
+            start = end + 1;
+        }
+        return arguments;
+    }
+
+    std::string requestInputFile(const std::vector<std::string> &arguments) {
+        for (size_t i = 0; i + 1 < arguments.size(); i++) {
+            if (arguments[i] == "-f") {
+                return arguments[i + 1];
+            }
+        }
+        return std::string();
+    }
+
+#ifdef _WIN32
+    void serve(const std::string &, size_t, const IModeParserFactory &,
+               std::chrono::milliseconds) {
+        throw depthmapX::RuntimeException("The server mode needs unix domain sockets and fork, "
+                                          "which are not available on Windows");
+    }
+#else
+    void serve(const std::string &socketPath, size_t cacheSize,
+               const IModeParserFactory &parserFactory,
+               std::chrono::milliseconds requestTimeout) {
+        sockaddr_un address{};
+        address.sun_family = AF_UNIX;
+        if (socketPath.size() >= sizeof(address.sun_path)) {
+            throw depthmapX::RuntimeException("Socket path is too long: " + socketPath);
+        }
+        std::strncpy(address.sun_path, socketPath.c_str(), sizeof(address.sun_path) - 1);
+
+        // a socket left behind by a server that was stopped, anything else
+        // at the path is left alone and makes bind fail
+        struct stat existing;
+        if (stat(socketPath.c_str(), &existing) == 0 && S_ISSOCK(existing.st_mode)) {
+            unlink(socketPath.c_str());
+        }
+
+        int listener = socket(AF_UNIX, SOCK_STREAM, 0);
+        if (listener < 0 ||
+            bind(listener, reinterpret_cast<sockaddr *>(&address), sizeof(address)) != 0 ||
+            listen(listener, 16) != 0) {
+            throw depthmapX::RuntimeException("Failed to listen on " + socketPath + ": " +
+                                              std::strerror(errno));
+        }
+        // the processes running the requests are not waited for
+        std::signal(SIGCHLD, SIG_IGN);
+
+        GraphCache cache(cacheSize);
+        PerformanceWriter loadTimes("");
+        std::cout << "Serving on " << socketPath << std::endl;
+        while (true) {
+            int connection = accept(listener, nullptr, nullptr);
+            if (connection < 0) {
+                if (errno == EINTR || errno == ECONNABORTED) {
+                    continue;
+                }
+                throw depthmapX::RuntimeException(std::string("Failed to accept connection: ") +
+                                                  std::strerror(errno));
+            }
+            timeval timeout{};
+            timeout.tv_sec = static_cast<time_t>(requestTimeout.count() / 1000);
+            timeout.tv_usec = static_cast<suseconds_t>((requestTimeout.count() % 1000) * 1000);
+            setsockopt(connection, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+            std::string line;
+            if (!readLine(connection, line, std::chrono::steady_clock::now() + requestTimeout)) {
+                close(connection);
+                continue;
+            }
+            auto arguments = splitRequest(line);
+            std::string inputFile = requestInputFile(arguments);
+            if (!inputFile.empty()) {
+                cache.load(inputFile, loadTimes);
+            }
+
+            std::cout << std::flush;
+            pid_t pid = fork();
+            if (pid == 0) {
+                close(listener);
+                dup2(connection, STDOUT_FILENO);
+                close(connection);
+                GraphCache::setCurrent(&cache);
+                int status = runRequest(arguments, parserFactory);
+                std::cout << std::flush;
+                _exit(status);
+            }
+            if (pid < 0) {
+                std::string message = std::string("ERROR Failed to start the request: ") +
+                                      std::strerror(errno) + "\n";
+                ssize_t written = write(connection, message.c_str(), message.size());
+                (void)written;
+            }
+            close(connection);
+        }
+    }
+#endif
+
+} // namespace dm_server
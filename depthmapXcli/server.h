@@ -0,0 +1,34 @@
+// SPDX-FileCopyrightText: 2026 depthmapX authors
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#pragma once
+
+// Server mode, which keeps graphs loaded between requests on a unix domain
+// socket. A request is one line of the arguments of a command line run,
+// separated by tabs. It is run in a process forked off the server, which
+// finds the graphs the server has loaded at hand and can change them without
+// touching the server's copy. The output of the run is sent back, followed by
+// a last line of either "OK <output file>" or "ERROR <message>". Requests
+// are read one at a time, so a client that has not sent its request line
+// within the request timeout is disconnected rather than keep the others
+// waiting
+
+#include "imodeparserfactory.h"
+
+#include <chrono>
+#include <string>
+#include <vector>
+
+namespace dm_server {
+    static constexpr std::chrono::milliseconds REQUEST_TIMEOUT{10000};
+
+    // serves requests until the process is stopped
+    void serve(const std::string &socketPath, size_t cacheSize,
+               const IModeParserFactory &parserFactory,
+               std::chrono::milliseconds requestTimeout = REQUEST_TIMEOUT);
+
+    std::vector<std::string> splitRequest(const std::string &line);
+    // the file given with -f, empty if there is none
+    std::string requestInputFile(const std::vector<std::string> &arguments);
+} // namespace dm_server
@@ -0,0 +1,244 @@
+// SPDX-FileCopyrightText: 2026 depthmapX authors
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "shortestpathsearch.h"
+
+#include <algorithm>
+
+namespace depthmapX {
+
+    void SearchLabels::init(size_t numNodes) {
+        dist.assign(numNodes, INF);
+        parent.assign(numNodes, NONE);
+        settled.assign(numNodes, 0);
+    }
+
+    void SearchLabels::reset() {
+        for (size_t node : touched) {
+            dist[node] = INF;
+            parent[node] = NONE;
+            settled[node] = 0;
+        }
+        touched.clear();
+    }
+
+    void SearchLabels::label(size_t node, double distance, size_t from) {
+        if (dist[node] == INF) {
+            touched.push_back(node);
+        }
+        dist[node] = distance;
+        parent[node] = from;
+    }
+
+    ShortestPathSearch::ShortestPathSearch(const CsrGraph &graph, const CsrGraph &reverseGraph)
+        : m_graph(graph), m_reverseGraph(reverseGraph) {
+        m_forward.init(graph.numNodes());
+        m_backward.init(graph.numNodes());
+        m_isTarget.assign(graph.numNodes(), 0);
+    }
+
+    PathResult ShortestPathSearch::bidirectional(const std::vector<size_t> &sources,
+                                                 const std::vector<size_t> &targets,
+                                                 bool withPath) {
+        return m_graph.isWeighted() ? bidirectionalSearch<true>(sources, targets, withPath)
+                                    : bidirectionalSearch<false>(sources, targets, withPath);
+    }
+
+    PathResult ShortestPathSearch::aStar(const std::vector<size_t> &sources,
+                                         const std::vector<size_t> &targets,
+                                         const std::function<double(size_t)> &heuristic,
+                                         bool withPath) {
+        return m_graph.isWeighted() ? aStarSearch<true>(sources, targets, heuristic, withPath)
+                                    : aStarSearch<false>(sources, targets, heuristic, withPath);
+    }
+
+    std::vector<double> ShortestPathSearch::distancesFrom(const std::vector<size_t> &sources,
+                                                          bool reverse) {
+        const CsrGraph &graph = reverse ? m_reverseGraph : m_graph;
+        m_forward.reset();
+        if (graph.isWeighted()) {
+            distancesFromSearch<true>(sources, graph);
+        } else {
+            distancesFromSearch<false>(sources, graph);
+        }
+        return m_forward.dist;
+    }
+
+    template <bool weighted>
+    PathResult ShortestPathSearch::bidirectionalSearch(const std::vector<size_t> &sources,
+                                                       const std::vector<size_t> &targets,
+                                                       bool withPath) {
+        m_forward.reset();
+        m_backward.reset();
+        m_forwardQueue.clear();
+        m_backwardQueue.clear();
+
+        for (size_t source : sources) {
+            m_forward.label(source, 0, NONE);
+            m_forwardQueue.push(0, source);
+        }
+        double best = INF;
+        size_t meeting = NONE;
+        for (size_t target : targets) {
+            m_backward.label(target, 0, NONE);
+            m_backwardQueue.push(0, target);
+            if (m_forward.dist[target] == 0) {
+                best = 0;
+                meeting = target;
+            }
+        }
+
+        while (!m_forwardQueue.empty() || !m_backwardQueue.empty()) {
+            double forwardTop = m_forwardQueue.empty() ? INF : m_forwardQueue.top().first;
+            double backwardTop = m_backwardQueue.empty() ? INF : m_backwardQueue.top().first;
+            if (forwardTop + backwardTop >= best) {
+                break;
+            }
+            bool forwardStep = forwardTop <= backwardTop;
+            RadixHeap &queue = forwardStep ? m_forwardQueue : m_backwardQueue;
+            SearchLabels &side = forwardStep ? m_forward : m_backward;
+            const SearchLabels &other = forwardStep ? m_backward : m_forward;
+            const CsrGraph &graph = forwardStep ? m_graph : m_reverseGraph;
+
+            auto [distance, node] = queue.pop();
+            if (side.settled[node] || distance > side.dist[node]) {
+                continue;
+            }
+            side.settled[node] = 1;
+            for (size_t e = graph.offsets[node]; e < graph.offsets[node + 1]; e++) {
+                size_t next = graph.targets[e];
+                double nextDistance = distance + edgeWeight<weighted>(graph, e);
+                if (nextDistance < side.dist[next]) {
+                    side.label(next, nextDistance, node);
+                    queue.push(nextDistance, next);
+                    if (other.dist[next] != INF && nextDistance + other.dist[next] < best) {
+                        best = nextDistance + other.dist[next];
+                        meeting = next;
+                    }
+                }
+            }
+        }
+
+        PathResult result;
+        if (meeting == NONE) {
+            return result;
+        }
+        result.distance = best;
+        if (withPath) {
+            for (size_t node = meeting; node != NONE; node = m_forward.parent[node]) {
+                result.nodes.push_back(node);
+            }
+            std::reverse(result.nodes.begin(), result.nodes.end());
+            for (size_t node = m_backward.parent[meeting]; node != NONE;
+                 node = m_backward.parent[node]) {
+                result.nodes.push_back(node);
+            }
+        }
+        return result;
+    }
+
+    template <bool weighted>
+    PathResult ShortestPathSearch::aStarSearch(const std::vector<size_t> &sources,
+                                               const std::vector<size_t> &targets,
+                                               const std::function<double(size_t)> &heuristic,
+                                               bool withPath) {
+        m_forward.reset();
+        m_forwardQueue.clear();
+        for (size_t target : targets) {
+            m_isTarget[target] = 1;
+        }
+
+        for (size_t source : sources) {
+            m_forward.label(source, 0, NONE);
+            m_forwardQueue.push(heuristic(source), source);
+        }
+
+        size_t reached = NONE;
+        while (!m_forwardQueue.empty()) {
+            size_t node = m_forwardQueue.pop().second;
+            if (m_forward.settled[node]) {
+                continue;
+            }
+            if (m_isTarget[node]) {
+                reached = node;
+                break;
+            }
+            m_forward.settled[node] = 1;
+            double distance = m_forward.dist[node];
+            for (size_t e = m_graph.offsets[node]; e < m_graph.offsets[node + 1]; e++) {
+                size_t next = m_graph.targets[e];
+                double nextDistance = distance + edgeWeight<weighted>(m_graph, e);
+                if (nextDistance < m_forward.dist[next]) {
+                    m_forward.label(next, nextDistance, node);
+                    m_forwardQueue.push(nextDistance + heuristic(next), next);
+                }
+            }
+        }
+
+        for (size_t target : targets) {
+            m_isTarget[target] = 0;
+        }
+
+        PathResult result;
+        if (reached == NONE) {
+            return result;
+        }
+        result.distance = m_forward.dist[reached];
+        if (withPath) {
+            for (size_t node = reached; node != NONE; node = m_forward.parent[node]) {
+                result.nodes.push_back(node);
+            }
+            std::reverse(result.nodes.begin(), result.nodes.end());
+        }
+        return result;
+    }
+
+    template <bool weighted>
+    void ShortestPathSearch::distancesFromSearch(const std::vector<size_t> &sources,
+                                                 const CsrGraph &graph) {
+        if constexpr (!weighted) {
+            // breadth first, every node is at its distance when first reached
+            m_frontier.clear();
+            for (size_t source : sources) {
+                if (m_forward.dist[source] == INF) {
+                    m_forward.label(source, 0, NONE);
+                    m_frontier.push_back(source);
+                }
+            }
+            for (size_t i = 0; i < m_frontier.size(); i++) {
+                size_t node = m_frontier[i];
+                m_forward.settled[node] = 1;
+                for (size_t e = graph.offsets[node]; e < graph.offsets[node + 1]; e++) {
+                    size_t next = graph.targets[e];
+                    if (m_forward.dist[next] == INF) {
+                        m_forward.label(next, m_forward.dist[node] + 1, node);
+                        m_frontier.push_back(next);
+                    }
+                }
+            }
+        } else {
+            m_forwardQueue.clear();
+            for (size_t source : sources) {
+                m_forward.label(source, 0, NONE);
+                m_forwardQueue.push(0, source);
+            }
+            while (!m_forwardQueue.empty()) {
+                auto [distance, node] = m_forwardQueue.pop();
+                if (m_forward.settled[node] || distance > m_forward.dist[node]) {
+                    continue;
+                }
+                m_forward.settled[node] = 1;
+                for (size_t e = graph.offsets[node]; e < graph.offsets[node + 1]; e++) {
+                    size_t next = graph.targets[e];
+                    double nextDistance = distance + edgeWeight<weighted>(graph, e);
+                    if (nextDistance < m_forward.dist[next]) {
+                        m_forward.label(next, nextDistance, node);
+                        m_forwardQueue.push(nextDistance, next);
+                    }
+                }
+            }
+        }
+    }
+
+} // namespace depthmapX
@@ -0,0 +1,103 @@
+// SPDX-FileCopyrightText: 2026 depthmapX authors
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#pragma once
+
+// Point to point shortest path searches over a CsrGraph. The sources and the
+// targets of a query are sets of nodes, the result being the shortest path from
+// any of the sources to any of the targets. Unweighted graphs count every edge
+// as 1. An instance keeps its scratch space between queries and only resets
+// what a query touched, so there should be one instance per thread
+
+#include "csrgraph.h"
+#include "radixheap.h"
+
+#include <functional>
+#include <limits>
+#include <vector>
+
+namespace depthmapX {
+
+    struct PathResult {
+        // negative if no target can be reached
+        double distance = -1;
+        // source to target, only filled if asked for
+        std::vector<size_t> nodes;
+
+        bool found() const { return distance >= 0; }
+    };
+
+    // Tentative distances and parents of one search direction. Resetting only
+    // clears the nodes the previous search touched
+    struct SearchLabels {
+        static constexpr double INF = std::numeric_limits<double>::infinity();
+        static constexpr size_t NONE = std::numeric_limits<size_t>::max();
+
+        std::vector<double> dist;
+        std::vector<size_t> parent;
+        std::vector<char> settled;
+        std::vector<size_t> touched;
+
+        void init(size_t numNodes);
+        void reset();
+        void label(size_t node, double distance, size_t from);
+    };
+
+    class ShortestPathSearch {
+      public:
+        // the reverse graph is only needed for bidirectional searches
+        ShortestPathSearch(const CsrGraph &graph, const CsrGraph &reverseGraph);
+
+        // Dijkstra from both ends at once, stopping once the two frontiers can
+        // not produce anything shorter than the best meeting found
+        PathResult bidirectional(const std::vector<size_t> &sources,
+                                 const std::vector<size_t> &targets, bool withPath);
+
+        // Forward A*, the heuristic must be consistent (never overestimate the
+        // distance from a node to the nearest target, and never drop by more
+        // than the weight of an edge) or the result may not be the shortest
+        PathResult aStar(const std::vector<size_t> &sources, const std::vector<size_t> &targets,
+                         const std::function<double(size_t)> &heuristic, bool withPath);
+
+        // Dijkstra from the sources to every node, over the reverse graph if
+        // asked for to get the distances to the sources instead. Nodes that
+        // can not be reached are at infinity
+        std::vector<double> distancesFrom(const std::vector<size_t> &sources, bool reverse);
+
+      private:
+        static constexpr double INF = SearchLabels::INF;
+        static constexpr size_t NONE = SearchLabels::NONE;
+
+        // The searches specialised on whether the graph is weighted, picked
+        // once per query so that the inner loops do not check it per edge
+        template <bool weighted>
+        PathResult bidirectionalSearch(const std::vector<size_t> &sources,
+                                       const std::vector<size_t> &targets, bool withPath);
+        template <bool weighted>
+        PathResult aStarSearch(const std::vector<size_t> &sources,
+                               const std::vector<size_t> &targets,
+                               const std::function<double(size_t)> &heuristic, bool withPath);
+        template <bool weighted>
+        void distancesFromSearch(const std::vector<size_t> &sources, const CsrGraph &graph);
+
+        template <bool weighted> static double edgeWeight(const CsrGraph &graph, size_t edge) {
+            if constexpr (weighted) {
+                return static_cast<double>(graph.weights[edge]);
+            } else {
+                return 1.0;
+            }
+        }
+
+        const CsrGraph &m_graph;
+        const CsrGraph &m_reverseGraph;
+        SearchLabels m_forward;
+        SearchLabels m_backward;
+        RadixHeap m_forwardQueue;
+        RadixHeap m_backwardQueue;
+        std::vector<char> m_isTarget;
+        // the queue of the breadth first searches of unweighted graphs
+        std::vector<size_t> m_frontier;
+    };
+
+} // namespace depthmapX
@@ -3,18 +3,72 @@
 // SPDX-License-Identifier: GPL-3.0-or-later
 
 #include "stepdepthparser.h"
+#include "cancellationtoken.h"
 #include "exceptions.h"
+#include "graphbuilders.h"
+#include "multisourcebfs.h"
 #include "parsingutils.h"
 #include "runmethods.h"
 #include "simpletimer.h"
+#include "taskscheduler.h"
 
 #include "salalib/entityparsing.h"
 
+#include <algorithm>
+#include <cctype>
 #include <cstring>
+#include <fstream>
+#include <map>
 #include <sstream>
+#include <unordered_map>
 
 using namespace depthmapX;
 
+namespace {
+    std::vector<std::string> splitTabLine(std::string line) {
+        if (!line.empty() && line.back() == '\r') {
+            line.pop_back();
+        }
+        std::vector<std::string> fields;
+        std::stringstream lineStream(line);
+        std::string field;
+        while (std::getline(lineStream, field, '\t')) {
+            fields.push_back(field);
+        }
+        return fields;
+    }
+
+    // The values of the column named group (in any case) of a point file, one
+    // per point. Empty if the file has no such column
+    std::vector<std::string> readGroupColumn(std::istream &stream, const std::string &filename) {
+        std::string line;
+        std::getline(stream, line);
+        auto header = splitTabLine(line);
+        auto groupColumn = std::find_if(header.begin(), header.end(), [](std::string name) {
+            std::transform(name.begin(), name.end(), name.begin(),
+                           [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+            return name == "group";
+        });
+        std::vector<std::string> groups;
+        if (groupColumn == header.end()) {
+            return groups;
+        }
+        size_t column = static_cast<size_t>(groupColumn - header.begin());
+        while (std::getline(stream, line)) {
+            auto fields = splitTabLine(line);
+            if (fields.empty()) {
+                continue;
+            }
+            if (fields.size() <= column) {
+                throw depthmapX::RuntimeException("Point without a group in " + filename + ": " +
+                                                  line);
+            }
+            groups.push_back(fields[column]);
+        }
+        return groups;
+    }
+} // namespace
+
 void StepDepthParser::parse(size_t argc, char **argv) {
 
     std::vector<std::string> points;
@@ -49,6 +103,8 @@ void StepDepthParser::parse(size_t argc, char **argv) {
             } else {
                 throw CommandLineException(std::string("Invalid step type: ") + argv[i]);
             }
+        } else if (std::strcmp("-sdm", argv[i]) == 0) {
+            m_multiSource = true;
         }
     }
 
@@ -66,6 +122,13 @@ void StepDepthParser::parse(size_t argc, char **argv) {
         }
         std::vector<Point2f> parsed = EntityParsing::parsePoints(pointsStream, '\t');
         m_stepDepthPoints.insert(std::end(m_stepDepthPoints), std::begin(parsed), std::end(parsed));
+
+        std::ifstream groupStream(pointFile);
+        m_stepDepthGroups = readGroupColumn(groupStream, pointFile);
+        if (!m_stepDepthGroups.empty() && m_stepDepthGroups.size() != m_stepDepthPoints.size()) {
+            throw depthmapX::RuntimeException("The group column of " + pointFile +
+                                              " does not give a group for every point");
+        }
     } else if (!points.empty()) {
         std::stringstream pointsStream;
         pointsStream << "x,y";
@@ -83,6 +146,11 @@ void StepDepthParser::parse(size_t argc, char **argv) {
 }
 
 void StepDepthParser::run(const CommandLineParser &clp, IPerformanceSink &perfWriter) const {
+    if (m_multiSource) {
+        runMultiSource(clp, perfWriter);
+        return;
+    }
+
     auto metaGraph = dm_runmethods::loadGraph(clp.getFileName().c_str(), perfWriter);
 
     std::cout << "ok\nSelecting cells... " << std::flush;
@@ -146,3 +214,185 @@ void StepDepthParser::run(const CommandLineParser &clp, IPerformanceSink &perfWr
              dm_runmethods::writeGraph(clp, metaGraph, clp.getOuputFile().c_str(), false))
     std::cout << " ok" << std::endl;
 }
+
+void StepDepthParser::runMultiSource(const CommandLineParser &clp,
+                                     IPerformanceSink &perfWriter) const {
+    auto metaGraph = dm_runmethods::loadGraph(clp.getFileName().c_str(), perfWriter);
+
+    auto graphRegion = metaGraph.getRegion();
+    for (auto &point : m_stepDepthPoints) {
+        if (!graphRegion.contains(point)) {
+            throw depthmapX::RuntimeException("Point outside of target region");
+        }
+    }
+
+    auto &map = metaGraph.getDisplayedPointMap();
+    auto &table = map.getAttributeTable();
+
+    // the origins are the groups of points of the group column, in the order
+    // they first appear and named by it, or else each point on its own named
+    // by its number
+    std::vector<std::string> groupNames;
+    std::vector<std::vector<size_t>> groupPoints;
+    std::map<std::string, size_t> groupIndices;
+    for (size_t i = 0; i < m_stepDepthPoints.size(); i++) {
+        std::string name = m_stepDepthGroups.empty() ? std::to_string(i + 1) : m_stepDepthGroups[i];
+        auto inserted = groupIndices.emplace(name, groupNames.size());
+        if (inserted.second) {
+            groupNames.push_back(name);
+            groupPoints.emplace_back();
+        }
+        groupPoints[inserted.first->second].push_back(i);
+    }
+
+    // a shard only analyses the origins of its range, naming their columns
+    // as the full analysis would
+    size_t firstOrigin = 0;
+    size_t endOrigin = groupNames.size();
+    if (clp.getOriginRange()) {
+        firstOrigin = std::min(clp.getOriginRange()->first, endOrigin);
+        endOrigin = std::min(clp.getOriginRange()->second, endOrigin);
+    }
+    // and of those only the points in the region of interest
+    auto regionOfInterest = dm_runmethods::loadRegionOfInterest(clp);
+    std::vector<size_t> origins;
+    for (size_t i = firstOrigin; i < endOrigin; i++) {
+        if (regionOfInterest) {
+            auto outside = std::remove_if(groupPoints[i].begin(), groupPoints[i].end(),
+                                          [&](size_t point) {
+                                              return !regionOfInterest->contains(
+                                                  m_stepDepthPoints[point]);
+                                          });
+            groupPoints[i].erase(outside, groupPoints[i].end());
+        }
+        if (!groupPoints[i].empty()) {
+            origins.push_back(i);
+        }
+    }
+    if (regionOfInterest) {
+        std::cout << origins.size() << " of " << endOrigin - firstOrigin
+                  << " origins in the region of interest... " << std::flush;
+    }
+
+    std::vector<size_t> depthColumns;
+    // origins not reached before the time budget ran out get no column
+    const auto &token = depthmapX::CancellationToken::global();
+
+    switch (m_stepType) {
+    case StepDepthParser::StepType::VISUAL: {
+        // visual step depth counts steps, so the origins can be carried
+        // together through the same breadth first search. Merged pixels are
+        // joined by edges of weight 0, at the depth of the pixel they are
+        // merged with as in salalib
+        std::cout << "ok\nBuilding visibility graph... " << std::flush;
+        std::vector<PixelRef> nodeRefs;
+        depthmapX::CsrGraph graph;
+        DO_TIMED("Building visibility graph",
+                 graph = dm_graphbuilders::pointMapVisibilityGraph(map.getInternalMap(), nodeRefs,
+                                                                  true))
+
+        std::unordered_map<int, size_t> nodeIndices;
+        for (size_t i = 0; i < nodeRefs.size(); i++) {
+            nodeIndices[nodeRefs[i]] = i;
+        }
+        std::vector<std::vector<size_t>> originGroups;
+        for (size_t i : origins) {
+            originGroups.emplace_back();
+            for (size_t point : groupPoints[i]) {
+                auto indexIter =
+                    nodeIndices.find(map.getInternalMap().pixelate(m_stepDepthPoints[point]));
+                if (indexIter == nodeIndices.end()) {
+                    throw depthmapX::RuntimeException("Point is not on a filled cell");
+                }
+                originGroups.back().push_back(indexIter->second);
+            }
+        }
+
+        std::cout << "ok\nCalculating step-depth... " << std::flush;
+        SimpleTimer t;
+        dm_runmethods::ColumnWriter writer(table,
+                                           std::vector<int>(nodeRefs.begin(), nodeRefs.end()));
+        // the batches are spread over the task scheduler a round of one batch
+        // per thread at a time, so that only the depths of those are held
+        // before they are written
+        size_t roundSize =
+            depthmapX::BFS_BATCH_SIZE * depthmapX::TaskScheduler::global().numThreads();
+        for (size_t start = 0; start < originGroups.size() && !token.isCancelled();
+             start += roundSize) {
+            size_t end = std::min(start + roundSize, originGroups.size());
+            std::vector<std::vector<size_t>> round(
+                originGroups.begin() + static_cast<long>(start),
+                originGroups.begin() + static_cast<long>(end));
+            auto depths = depthmapX::multiSourceStepDepth(graph, round, token);
+            for (size_t group = 0; group < depths.size(); group++) {
+                if (depths[group].empty()) {
+                    // its batch was not started before the token was cancelled
+                    continue;
+                }
+                depthColumns.push_back(writer.write(
+                    "Visual Step Depth " + groupNames[origins[start + group]],
+                    depths[group]));
+            }
+        }
+        perfWriter.addData("Calculating step-depth", t.getTimeInSeconds());
+        break;
+    }
+    case StepDepthParser::StepType::METRIC:
+    case StepDepthParser::StepType::ANGULAR: {
+        // weighted searches can not share a frontier, run them one origin at
+        // a time on the already loaded map and keep a copy of each result
+        Options options;
+        options.global = 0;
+        options.pointDepthSelection = m_stepType == StepDepthParser::StepType::METRIC ? 2 : 3;
+        std::string resultColumn = m_stepType == StepDepthParser::StepType::METRIC
+                                       ? "Metric Step Depth"
+                                       : "Angular Step Depth";
+
+        std::cout << "ok\nCalculating step-depth... " << std::flush;
+        SimpleTimer t;
+        for (size_t i : origins) {
+            if (token.isCancelled()) {
+                break;
+            }
+            metaGraph.clearSel();
+            for (size_t point : groupPoints[i]) {
+                QtRegion r(m_stepDepthPoints[point], m_stepDepthPoints[point]);
+                metaGraph.setCurSel(r, true);
+            }
+            auto comm = dm_runmethods::getCommunicator(clp);
+            metaGraph.analyseGraph(comm.get(), options, false);
+            if (comm && comm->IsCancelled()) {
+                // stopped part of the way through this origin
+                break;
+            }
+
+            size_t from = table.getColumnIndex(resultColumn);
+            size_t to = table.insertOrResetColumn(resultColumn + " " + groupNames[i]);
+            for (auto iter = table.begin(); iter != table.end(); ++iter) {
+                iter->getRow().setValue(to, iter->getRow().getValue(from));
+            }
+            depthColumns.push_back(to);
+        }
+        metaGraph.clearSel();
+        perfWriter.addData("Calculating step-depth", t.getTimeInSeconds());
+        break;
+    }
+    default: {
+        throw depthmapX::SetupCheckException("Error, unsupported step type");
+    }
+    }
+
+    if (depthColumns.size() < origins.size()) {
+        std::cout << "time budget ran out after " << depthColumns.size() << " of "
+                  << origins.size() << " origins... " << std::flush;
+    }
+    if (!depthColumns.empty()) {
+        map.overrideDisplayedAttribute(-2);
+        map.setDisplayedAttribute(static_cast<int>(depthColumns.front()));
+    }
+
+    std::cout << " ok\nWriting out result..." << std::flush;
+    DO_TIMED("Writing graph",
+             dm_runmethods::writeGraph(clp, metaGraph, clp.getOuputFile().c_str(), false))
+    std::cout << " ok" << std::endl;
+}
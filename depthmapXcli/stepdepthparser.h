@@ -12,7 +12,7 @@
 
 class StepDepthParser : public IModeParser {
   public:
-    StepDepthParser() : m_stepType(StepType::NONE) {}
+    StepDepthParser() : m_stepType(StepType::NONE), m_multiSource(false) {}
 
     std::string getModeName() const override { return "STEPDEPTH"; }
 
@@ -22,7 +22,12 @@ class StepDepthParser : public IModeParser {
                "repeated\n"
                "  -sdf <step depth point file> a file with a point per line to calculate step "
                "depth from\n"
-               "  -sdt <type> step type. One of metric, angular or visual\n";
+               "  -sdt <type> step type. One of metric, angular or visual\n"
+               "  -sdm calculate a separate step depth column from each point instead of one\n"
+               "       column from all of them. Points given with -sdf that share a value in a\n"
+               "       column named group share a column instead, named by that value. Visual\n"
+               "       step depths are calculated for up to 64 origins at a time in a single\n"
+               "       pass over the map\n";
     }
 
     enum class StepType { NONE, ANGULAR, METRIC, VISUAL };
@@ -33,10 +38,19 @@ class StepDepthParser : public IModeParser {
 
     std::vector<Point2f> getStepDepthPoints() const { return m_stepDepthPoints; }
 
+    // the group of each point from the group column of -sdf, empty if none
+    const std::vector<std::string> &getStepDepthGroups() const { return m_stepDepthGroups; }
+
     StepType getStepType() const { return m_stepType; }
 
+    bool isMultiSource() const { return m_multiSource; }
+
   private:
+    void runMultiSource(const CommandLineParser &clp, IPerformanceSink &perfWriter) const;
+
     std::vector<Point2f> m_stepDepthPoints;
+    std::vector<std::string> m_stepDepthGroups;
 
     StepType m_stepType;
+    bool m_multiSource;
 };
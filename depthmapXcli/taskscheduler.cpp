@@ -0,0 +1,199 @@
+// SPDX-FileCopyrightText: 2026 depthmapX authors
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "taskscheduler.h"
+
+#include <algorithm>
+
+namespace {
+    // the scheduler the current thread is a worker of, and its queue there
+    thread_local const depthmapX::TaskScheduler *t_scheduler = nullptr;
+    thread_local size_t t_queue = 0;
+
+    std::mutex globalMutex;
+    std::unique_ptr<depthmapX::TaskScheduler> globalScheduler;
+
+    size_t hardwareThreads() {
+        return std::max<size_t>(1, std::thread::hardware_concurrency());
+    }
+} // namespace
+
+namespace depthmapX {
+
+    TaskGroup::TaskGroup(TaskScheduler &scheduler) : m_scheduler(scheduler) {}
+
+    TaskGroup::~TaskGroup() { drain(); }
+
+    void TaskGroup::spawn(std::function<void()> task) {
+        m_pending++;
+        m_scheduler.submit({std::move(task), this});
+    }
+
+    void TaskGroup::drain() {
+        while (m_pending > 0) {
+            if (m_scheduler.runOne()) {
+                continue;
+            }
+            // the rest is running elsewhere, sleep until it is done or there
+            // is more to run
+            std::unique_lock<std::mutex> lock(m_scheduler.m_sleepMutex);
+            m_scheduler.m_wake.wait(
+                lock, [this]() { return m_pending == 0 || m_scheduler.m_queued > 0; });
+        }
+    }
+
+    void TaskGroup::wait() {
+        drain();
+        std::exception_ptr exception;
+        {
+            std::lock_guard<std::mutex> lock(m_exceptionMutex);
+            std::swap(exception, m_exception);
+        }
+        if (exception) {
+            std::rethrow_exception(exception);
+        }
+    }
+
+    void TaskGroup::run(const std::function<void()> &task) {
+        if (!m_cancelled) {
+            try {
+                task();
+            } catch (...) {
+                std::lock_guard<std::mutex> lock(m_exceptionMutex);
+                if (!m_exception) {
+                    m_exception = std::current_exception();
+                }
+                m_cancelled = true;
+            }
+        }
+        // the group may be gone as soon as this reaches zero. Taking the
+        // sleep mutex after makes sure a waiter has either seen it or is
+        // asleep and gets woken
+        TaskScheduler &scheduler = m_scheduler;
+        if (--m_pending == 0) {
+            { std::lock_guard<std::mutex> lock(scheduler.m_sleepMutex); }
+            scheduler.m_wake.notify_all();
+        }
+    }
+
+    void TaskGroup::parallelFor(size_t begin, size_t end, size_t grainSize,
+                                const std::function<void(size_t, size_t)> &body) {
+        grainSize = std::max<size_t>(1, grainSize);
+        for (size_t rangeBegin = begin; rangeBegin < end;) {
+            size_t rangeEnd = end - rangeBegin > grainSize ? rangeBegin + grainSize : end;
+            spawn([&body, rangeBegin, rangeEnd]() { body(rangeBegin, rangeEnd); });
+            rangeBegin = rangeEnd;
+        }
+        wait();
+    }
+
+    TaskScheduler::TaskScheduler(size_t numThreads) {
+        size_t numWorkers = std::max<size_t>(1, numThreads) - 1;
+        for (size_t i = 0; i < numWorkers + 1; i++) {
+            m_queues.push_back(std::make_unique<TaskQueue>());
+        }
+        for (size_t i = 0; i < numWorkers; i++) {
+            m_workers.emplace_back(&TaskScheduler::workerLoop, this, i);
+        }
+    }
+
+    TaskScheduler::~TaskScheduler() {
+        {
+            std::lock_guard<std::mutex> lock(m_sleepMutex);
+            m_stopping = true;
+        }
+        m_wake.notify_all();
+        for (auto &worker : m_workers) {
+            worker.join();
+        }
+    }
+
+    void TaskScheduler::parallelFor(size_t begin, size_t end, size_t grainSize,
+                                    const std::function<void(size_t, size_t)> &body) {
+        TaskGroup group(*this);
+        group.parallelFor(begin, end, grainSize, body);
+    }
+
+    TaskScheduler &TaskScheduler::global() {
+        std::lock_guard<std::mutex> lock(globalMutex);
+        if (!globalScheduler) {
+            globalScheduler = std::make_unique<TaskScheduler>(hardwareThreads());
+        }
+        return *globalScheduler;
+    }
+
+    void TaskScheduler::setGlobalThreads(size_t numThreads) {
+        std::lock_guard<std::mutex> lock(globalMutex);
+        globalScheduler.reset();
+        globalScheduler =
+            std::make_unique<TaskScheduler>(numThreads == 0 ? hardwareThreads() : numThreads);
+    }
+
+    size_t TaskScheduler::ownQueue() const {
+        return t_scheduler == this ? t_queue : m_queues.size() - 1;
+    }
+
+    void TaskScheduler::submit(Task task) {
+        {
+            std::lock_guard<std::mutex> lock(m_sleepMutex);
+            m_queued++;
+        }
+        {
+            TaskQueue &queue = *m_queues[ownQueue()];
+            std::lock_guard<std::mutex> lock(queue.mutex);
+            queue.tasks.push_back(std::move(task));
+        }
+        m_wake.notify_one();
+    }
+
+    bool TaskScheduler::takeTask(Task &task) {
+        size_t own = ownQueue();
+        {
+            TaskQueue &queue = *m_queues[own];
+            std::lock_guard<std::mutex> lock(queue.mutex);
+            if (!queue.tasks.empty()) {
+                task = std::move(queue.tasks.back());
+                queue.tasks.pop_back();
+                m_queued--;
+                return true;
+            }
+        }
+        for (size_t i = 1; i < m_queues.size(); i++) {
+            TaskQueue &queue = *m_queues[(own + i) % m_queues.size()];
+            std::lock_guard<std::mutex> lock(queue.mutex);
+            if (!queue.tasks.empty()) {
+                task = std::move(queue.tasks.front());
+                queue.tasks.pop_front();
+                m_queued--;
+                return true;
+            }
+        }
+        return false;
+    }
+
+    bool TaskScheduler::runOne() {
+        Task task;
+        if (!takeTask(task)) {
+            return false;
+        }
+        task.group->run(task.function);
+        return true;
+    }
+
+    void TaskScheduler::workerLoop(size_t queue) {
+        t_scheduler = this;
+        t_queue = queue;
+        while (true) {
+            if (runOne()) {
+                continue;
+            }
+            std::unique_lock<std::mutex> lock(m_sleepMutex);
+            m_wake.wait(lock, [this]() { return m_stopping || m_queued > 0; });
+            if (m_stopping) {
+                return;
+            }
+        }
+    }
+
+} // namespace depthmapX
@@ -0,0 +1,120 @@
+// SPDX-FileCopyrightText: 2026 depthmapX authors
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#pragma once
+
+// Work-stealing task scheduler shared by the analyses run in one process, so
+// that running several of them does not start more threads than there are
+// cores. Each worker thread takes work from its own queue first, newest task
+// first, and steals the oldest tasks of the others when it runs out. Threads
+// waiting on a task group run queued tasks while they wait, so task groups can
+// be nested and a scheduler with a single thread runs everything inline, and
+// sleep alongside the idle workers once there is nothing left to run
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace depthmapX {
+
+    class TaskScheduler;
+
+    // Tasks that are waited on together. Cancelling the group skips those of
+    // its tasks that have not started yet. A task that throws cancels the
+    // group, and the exception is rethrown by wait()
+    class TaskGroup {
+      public:
+        explicit TaskGroup(TaskScheduler &scheduler);
+        // waits for the tasks still running, dropping any exception
+        ~TaskGroup();
+        TaskGroup(const TaskGroup &) = delete;
+        TaskGroup &operator=(const TaskGroup &) = delete;
+
+        void spawn(std::function<void()> task);
+        void wait();
+
+        // Runs body on consecutive ranges of [begin, end) of at most
+        // grainSize items each, in parallel, and waits for all of them
+        void parallelFor(size_t begin, size_t end, size_t grainSize,
+                         const std::function<void(size_t, size_t)> &body);
+
+        void cancel() { m_cancelled = true; }
+        bool isCancelled() const { return m_cancelled; }
+
+      private:
+        friend class TaskScheduler;
+
+        void run(const std::function<void()> &task);
+        void drain();
+
+        TaskScheduler &m_scheduler;
+        std::atomic<size_t> m_pending{0};
+        std::atomic<bool> m_cancelled{false};
+        std::mutex m_exceptionMutex;
+        std::exception_ptr m_exception;
+    };
+
+    class TaskScheduler {
+      public:
+        // numThreads includes the thread that waits on the task groups, so
+        // one less worker thread is started
+        explicit TaskScheduler(size_t numThreads);
+        ~TaskScheduler();
+        TaskScheduler(const TaskScheduler &) = delete;
+        TaskScheduler &operator=(const TaskScheduler &) = delete;
+
+        size_t numThreads() const { return m_workers.size() + 1; }
+
+        // TaskGroup::parallelFor in a group of its own
+        void parallelFor(size_t begin, size_t end, size_t grainSize,
+                         const std::function<void(size_t, size_t)> &body);
+
+        // The scheduler of the process, with one thread per hardware thread
+        // unless set otherwise
+        static TaskScheduler &global();
+        // Replaces the global scheduler with one of numThreads threads (0 for
+        // one per hardware thread). It must not be in use at the time
+        static void setGlobalThreads(size_t numThreads);
+
+      private:
+        friend class TaskGroup;
+
+        struct Task {
+            std::function<void()> function;
+            TaskGroup *group;
+        };
+
+        struct TaskQueue {
+            std::mutex mutex;
+            std::deque<Task> tasks;
+        };
+
+        void submit(Task task);
+        // runs one queued task, false if there was none
+        bool runOne();
+        bool takeTask(Task &task);
+        size_t ownQueue() const;
+        void workerLoop(size_t queue);
+
+        // one queue per worker thread, then one for all other threads
+        std::vector<std::unique_ptr<TaskQueue>> m_queues;
+        std::vector<std::thread> m_workers;
+        std::mutex m_sleepMutex;
+        // wakes the idle workers and the threads waiting on task groups, for
+        // a queued task, a finished group or stopping
+        std::condition_variable m_wake;
+        // queued tasks, only ever raised under m_sleepMutex so that no wake up
+        // is missed. Raised before the task is queued, so it can briefly be
+        // ahead of the queues
+        std::atomic<long> m_queued{0};
+        bool m_stopping = false;
+    };
+
+} // namespace depthmapX
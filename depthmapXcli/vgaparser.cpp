@@ -4,17 +4,20 @@
 
 #include "vgaparser.h"
 #include "exceptions.h"
+#include "graphbuilders.h"
 #include "parsingutils.h"
 #include "radiusconverter.h"
 #include "runmethods.h"
 #include "simpletimer.h"
+#include "visuallocal.h"
 
 #include <cstring>
 
 using namespace depthmapX;
 
 VgaParser::VgaParser()
-    : m_vgaMode(VgaMode::NONE), m_localMeasures(false), m_globalMeasures(false) {}
+    : m_vgaMode(VgaMode::NONE), m_localMeasures(false), m_bitsetLocalMeasures(false),
+      m_globalMeasures(false) {}
 
 void VgaParser::parse(size_t argc, char *argv[]) {
     for (size_t i = 1; i < argc;) {
@@ -42,6 +45,9 @@ void VgaParser::parse(size_t argc, char *argv[]) {
             m_globalMeasures = true;
         } else if (std::strcmp(argv[i], "-vl") == 0) {
             m_localMeasures = true;
+        } else if (std::strcmp(argv[i], "-vlb") == 0) {
+            m_localMeasures = true;
+            m_bitsetLocalMeasures = true;
         } else if (std::strcmp(argv[i], "-vr") == 0) {
             ENFORCE_ARGUMENT("-vr", i)
             m_radius = argv[i];
@@ -53,6 +59,10 @@ void VgaParser::parse(size_t argc, char *argv[]) {
         m_vgaMode = VgaMode::ISOVIST;
     }
 
+    if (m_bitsetLocalMeasures && m_vgaMode != VgaMode::VISBILITY) {
+        throw CommandLineException("-vlb can only be used with visibility analysis");
+    }
+
     if (m_vgaMode == VgaMode::VISBILITY && m_globalMeasures) {
         if (m_radius.empty()) {
             throw CommandLineException(
@@ -74,13 +84,44 @@ void VgaParser::run(const CommandLineParser &clp, IPerformanceSink &perfWriter)
     RadiusConverter converter;
     auto metaGraph = dm_runmethods::loadGraph(clp.getFileName().c_str(), perfWriter);
 
+    if (clp.getSampleFraction() > 0) {
+        if (getVgaMode() != VgaMode::VISBILITY || !globalMeasures() || localMeasures() ||
+            getRadius() != "n") {
+            throw depthmapX::RuntimeException(
+                "Sampled VGA (-sa) requires visibility analysis of global measures at radius n");
+        }
+        auto &map = metaGraph.getDisplayedPointMap();
+        std::cout << "Building visibility graph... " << std::flush;
+        std::vector<PixelRef> nodeRefs;
+        depthmapX::CsrGraph graph;
+        DO_TIMED("Building visibility graph",
+                 graph = dm_graphbuilders::pointMapVisibilityGraph(map.getInternalMap(), nodeRefs,
+                                                                  true))
+        std::vector<Point2f> positions;
+        std::vector<int> keys;
+        for (const PixelRef &ref : nodeRefs) {
+            positions.push_back(map.getInternalMap().depixelate(ref));
+            keys.push_back(ref);
+        }
+        std::cout << "ok\nAnalysing graph... " << std::flush;
+        dm_runmethods::runSampledCentrality(clp, perfWriter, graph, 1, positions, keys, false, true,
+                                            "Visual ", map.getAttributeTable());
+
+        std::cout << " ok\nWriting out result..." << std::flush;
+        DO_TIMED("Writing graph",
+                 dm_runmethods::writeGraph(clp, metaGraph, clp.getOuputFile().c_str(), false))
+        std::cout << " ok" << std::endl;
+        return;
+    }
+
     std::unique_ptr<Options> options(new Options());
 
     std::cout << "Getting options..." << std::flush;
     switch (getVgaMode()) {
     case VgaParser::VgaMode::VISBILITY:
         options->outputType = AnalysisType::VISUAL;
-        options->local = localMeasures();
+        // with -vlb the local measures are computed here instead of by salalib
+        options->local = localMeasures() && !bitsetLocalMeasures();
         options->global = globalMeasures();
         if (options->global) {
             options->radius = converter.ConvertForVisibility(getRadius());
@@ -105,8 +146,13 @@ void VgaParser::run(const CommandLineParser &clp, IPerformanceSink &perfWriter)
     std::cout << " ok\nAnalysing graph..." << std::flush;
 
     std::optional<std::string> mimicVersion = clp.getMimickVersion();
+    if (bitsetLocalMeasures() && mimicVersion.has_value()) {
+        throw depthmapX::RuntimeException("-vlb can not be used when mimicking older versions");
+    }
 
-    if (!mimicVersion.has_value()) {
+    if (bitsetLocalMeasures() && !globalMeasures()) {
+        // nothing left for salalib to do
+    } else if (!mimicVersion.has_value()) {
         // current version
         DO_TIMED("Run VGA", metaGraph.analyseGraph(dm_runmethods::getCommunicator(clp).get(),
                                                    *options, clp.simpleMode());)
@@ -137,6 +183,35 @@ void VgaParser::run(const CommandLineParser &clp, IPerformanceSink &perfWriter)
         }
     }
 
+    if (bitsetLocalMeasures()) {
+        auto &map = metaGraph.getDisplayedPointMap();
+        std::vector<PixelRef> nodeRefs;
+        depthmapX::CsrGraph graph;
+        DO_TIMED("Building visibility graph",
+                 graph = dm_graphbuilders::pointMapVisibilityGraph(map.getInternalMap(), nodeRefs,
+                                                                  false))
+        depthmapX::VisualLocalMeasures measures;
+        // the limit counts the graph built here and the sorted copy of it the
+        // measures take, and the neighbour bitsets get whatever they leave
+        size_t bitsetBytes = depthmapX::VISUAL_LOCAL_BITSET_BYTES;
+        if (clp.getMemoryLimit() > 0) {
+            size_t graphBytes =
+                2 * (graph.offsets.size() + graph.targets.size()) * sizeof(size_t);
+            bitsetBytes = clp.getMemoryLimit() > graphBytes ? clp.getMemoryLimit() - graphBytes : 0;
+        }
+        DO_TIMED("Visual local measures",
+                 measures = depthmapX::visualLocalMeasures(graph, bitsetBytes))
+        std::vector<int> keys(nodeRefs.begin(), nodeRefs.end());
+        dm_runmethods::ColumnWriter writer(map.getAttributeTable(), keys);
+        size_t clusteringCol = writer.write("Visual Clustering Coefficient", measures.clustering);
+        writer.write("Visual Control", measures.control);
+        writer.write("Visual Controllability", measures.controllability);
+        if (!globalMeasures()) {
+            map.overrideDisplayedAttribute(-2);
+            map.setDisplayedAttribute(static_cast<int>(clusteringCol));
+        }
+    }
+
     std::cout << " ok\nWriting out result..." << std::flush;
     DO_TIMED("Writing graph",
              dm_runmethods::writeGraph(clp, metaGraph, clp.getOuputFile().c_str(), false))
@@ -18,6 +18,8 @@ class VgaParser : public IModeParser {
                "-vm <vga mode> one of isovist, visiblity, metric, angular, thruvision\n"
                "-vg turn on global measures for visibility, requires radius between 1 and 99 or n\n"
                "-vl turn on local measures for visibility\n"
+               "-vlb turn on local measures for visibility, computed in the cli from neighbour\n"
+               "     bitsets\n"
                "-vr set visibility radius\n";
     }
 
@@ -31,6 +33,7 @@ class VgaParser : public IModeParser {
     // vga options
     VgaMode getVgaMode() const { return m_vgaMode; }
     bool localMeasures() const { return m_localMeasures; }
+    bool bitsetLocalMeasures() const { return m_bitsetLocalMeasures; }
     bool globalMeasures() const { return m_globalMeasures; }
     const std::string &getRadius() const { return m_radius; }
 
@@ -38,6 +41,7 @@ class VgaParser : public IModeParser {
     // vga options
     VgaMode m_vgaMode;
     bool m_localMeasures;
+    bool m_bitsetLocalMeasures;
     bool m_globalMeasures;
     std::string m_radius;
 };
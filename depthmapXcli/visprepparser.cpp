@@ -47,7 +47,6 @@ void VisPrepParser::parse(size_t argc, char **argv) {
     // Unmake graph + Anything else = Pointless action
 
     std::vector<std::string> points;
-    std::string pointFile;
     for (size_t i = 1; i < argc; ++i) {
         if (std::strcmp("-pg", argv[i]) == 0) {
             if (m_grid >= 0) {
@@ -59,7 +58,7 @@ void VisPrepParser::parse(size_t argc, char **argv) {
                 throw CommandLineException(std::string("-pg must be a number >0, got ") + argv[i]);
             }
         } else if (std::strcmp("-pp", argv[i]) == 0) {
-            if (!pointFile.empty()) {
+            if (!m_fillPointFile.empty()) {
                 throw CommandLineException("-pp cannot be used together with -pf");
             }
             ENFORCE_ARGUMENT("-pp", i)
@@ -75,7 +74,7 @@ void VisPrepParser::parse(size_t argc, char **argv) {
                 throw CommandLineException("-pf cannot be used together with -pp");
             }
             ENFORCE_ARGUMENT("-pf", i)
-            pointFile = argv[i];
+            m_fillPointFile = argv[i];
         } else if (std::strcmp("-pr", argv[i]) == 0) {
             ENFORCE_ARGUMENT("-pr", i);
             m_maxVisibility = std::atof(argv[i]);
@@ -102,22 +101,22 @@ void VisPrepParser::parse(size_t argc, char **argv) {
         }
     }
 
-    if (!getMakeGraph() && !getUnmakeGraph() && m_grid <= 0 && pointFile.empty() &&
+    if (!getMakeGraph() && !getUnmakeGraph() && m_grid <= 0 && m_fillPointFile.empty() &&
         points.empty()) {
         throw CommandLineException("Nothing to do");
     }
 
-    if (m_grid > 0 && getMakeGraph() && pointFile.empty() && points.empty()) {
+    if (m_grid > 0 && getMakeGraph() && m_fillPointFile.empty() && points.empty()) {
         throw CommandLineException("Creating a graph for an unfilled grid is not possible. "
                                    "Either -pp or -pf must be given");
     }
 
-    if (!pointFile.empty()) {
-        std::ifstream pointsStream(pointFile);
+    if (!m_fillPointFile.empty()) {
+        std::ifstream pointsStream(m_fillPointFile);
         if (!pointsStream) {
             std::stringstream message;
-            message << "Failed to load file " << pointFile << ", error " << std::strerror(errno)
-                    << std::flush;
+            message << "Failed to load file " << m_fillPointFile << ", error "
+                    << std::strerror(errno) << std::flush;
             throw depthmapX::RuntimeException(message.str().c_str());
         }
         std::vector<Point2f> parsed = EntityParsing::parsePoints(pointsStream, '\t');
@@ -143,6 +142,14 @@ void VisPrepParser::parse(size_t argc, char **argv) {
 }
 
 void VisPrepParser::run(const CommandLineParser &clp, IPerformanceSink &perfWriter) const {
+    std::string productKey;
+    std::vector<std::string> dataFiles;
+    if (!m_fillPointFile.empty()) {
+        dataFiles.push_back(m_fillPointFile);
+    }
+    if (dm_runmethods::fetchCachedProduct(clp, perfWriter, productKey, dataFiles)) {
+        return;
+    }
     auto metaGraph = dm_runmethods::loadGraph(clp.getFileName().c_str(), perfWriter);
 
     std::optional<std::string> mimicVersion = clp.getMimickVersion();
@@ -213,4 +220,5 @@ void VisPrepParser::run(const CommandLineParser &clp, IPerformanceSink &perfWrit
     DO_TIMED("Writing graph",
              dm_runmethods::writeGraph(clp, metaGraph, clp.getOuputFile().c_str(), false))
     std::cout << " ok" << std::endl;
+    dm_runmethods::storeCachedProduct(clp, productKey, perfWriter);
 }
@@ -46,6 +46,8 @@ class VisPrepParser : public IModeParser {
   private:
     double m_grid;
     std::vector<Point2f> m_fillPoints;
+    // for the product cache, which keys on its contents
+    std::string m_fillPointFile;
     double m_maxVisibility;
     bool m_boundaryGraph;
     bool m_makeGraph;
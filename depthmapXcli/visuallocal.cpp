@@ -0,0 +1,143 @@
+// SPDX-FileCopyrightText: 2026 depthmapX authors
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "visuallocal.h"
+
+#include "taskscheduler.h"
+
+#include <algorithm>
+#include <bitset>
+#include <cstdint>
+#include <limits>
+
+namespace {
+    constexpr size_t NO_BITSET = std::numeric_limits<size_t>::max();
+
+    size_t popcount(uint64_t word) { return std::bitset<64>(word).count(); }
+} // namespace
+
+namespace depthmapX {
+
+    VisualLocalMeasures visualLocalMeasures(const CsrGraph &graph, size_t maxBitsetBytes) {
+        size_t numNodes = graph.numNodes();
+
+        // the neighbourhoods sorted, without duplicates and without the
+        // node itself
+        CsrGraph hoods;
+        hoods.offsets.reserve(numNodes + 1);
+        hoods.targets.reserve(graph.numEdges());
+        for (size_t v = 0; v < numNodes; v++) {
+            for (size_t e = graph.offsets[v]; e < graph.offsets[v + 1]; e++) {
+                if (graph.targets[e] != v) {
+                    hoods.targets.push_back(graph.targets[e]);
+                }
+            }
+            auto begin = hoods.targets.begin() + static_cast<long>(hoods.offsets.back());
+            std::sort(begin, hoods.targets.end());
+            hoods.targets.erase(std::unique(begin, hoods.targets.end()), hoods.targets.end());
+            hoods.offsets.push_back(hoods.targets.size());
+        }
+
+        // bitsets for the nodes that see at least as many cells as there are
+        // words in a bitset, most cells first, as far as the memory allows
+        size_t numWords = (numNodes + 63) / 64;
+        std::vector<size_t> dense;
+        for (size_t v = 0; v < numNodes; v++) {
+            if (numWords > 0 && hoods.degree(v) >= numWords) {
+                dense.push_back(v);
+            }
+        }
+        std::stable_sort(dense.begin(), dense.end(),
+                         [&](size_t a, size_t b) { return hoods.degree(a) > hoods.degree(b); });
+        size_t bytesPerBitset = numWords * sizeof(uint64_t);
+        dense.resize(std::min(dense.size(), bytesPerBitset > 0 ? maxBitsetBytes / bytesPerBitset
+                                                               : size_t(0)));
+        std::vector<size_t> bitsetIndex(numNodes, NO_BITSET);
+        std::vector<uint64_t> bitsets(dense.size() * numWords);
+        for (size_t i = 0; i < dense.size(); i++) {
+            bitsetIndex[dense[i]] = i;
+            uint64_t *bits = &bitsets[i * numWords];
+            for (size_t e = hoods.offsets[dense[i]]; e < hoods.offsets[dense[i] + 1]; e++) {
+                bits[hoods.targets[e] / 64] |= uint64_t(1) << (hoods.targets[e] % 64);
+            }
+        }
+
+        VisualLocalMeasures measures;
+        measures.clustering.assign(numNodes, -1);
+        measures.control.assign(numNodes, -1);
+        measures.controllability.assign(numNodes, -1);
+
+        auto &scheduler = TaskScheduler::global();
+        size_t grainSize = numNodes / (4 * scheduler.numThreads()) + 1;
+        scheduler.parallelFor(0, numNodes, grainSize, [&](size_t rangeBegin, size_t rangeEnd) {
+            // the neighbourhood of the current node and the union of those
+            // of its neighbours
+            std::vector<uint64_t> seen(numWords), reach(numWords);
+            for (size_t v = rangeBegin; v < rangeEnd; v++) {
+                size_t begin = hoods.offsets[v];
+                size_t end = hoods.offsets[v + 1];
+                size_t numSeen = end - begin;
+                if (numSeen == 0) {
+                    continue;
+                }
+                for (size_t e = begin; e < end; e++) {
+                    seen[hoods.targets[e] / 64] |= uint64_t(1) << (hoods.targets[e] % 64);
+                }
+                std::copy(seen.begin(), seen.end(), reach.begin());
+                reach[v / 64] |= uint64_t(1) << (v % 64);
+                // the words the neighbourhood spans, as the hoods are sorted
+                size_t firstWord = hoods.targets[begin] / 64;
+                size_t lastWord = hoods.targets[end - 1] / 64;
+
+                size_t linked = 0;
+                double control = 0;
+                for (size_t e = begin; e < end; e++) {
+                    size_t j = hoods.targets[e];
+                    size_t jBegin = hoods.offsets[j];
+                    size_t jEnd = hoods.offsets[j + 1];
+                    control += 1.0 / static_cast<double>(jEnd - jBegin + 1);
+                    if (jBegin == jEnd) {
+                        continue;
+                    }
+                    if (bitsetIndex[j] != NO_BITSET) {
+                        const uint64_t *bits = &bitsets[bitsetIndex[j] * numWords];
+                        for (size_t w = firstWord; w <= lastWord; w++) {
+                            linked += popcount(seen[w] & bits[w]);
+                        }
+                        size_t jLastWord = hoods.targets[jEnd - 1] / 64;
+                        for (size_t w = hoods.targets[jBegin] / 64; w <= jLastWord; w++) {
+                            reach[w] |= bits[w];
+                        }
+                    } else {
+                        for (size_t f = jBegin; f < jEnd; f++) {
+                            size_t u = hoods.targets[f];
+                            uint64_t bit = uint64_t(1) << (u % 64);
+                            linked += (seen[u / 64] & bit) != 0;
+                            reach[u / 64] |= bit;
+                        }
+                    }
+                }
+
+                size_t numReached = 0;
+                for (uint64_t word : reach) {
+                    numReached += popcount(word);
+                }
+                if (numSeen > 1) {
+                    measures.clustering[v] = static_cast<double>(linked) /
+                                             static_cast<double>(numSeen * (numSeen - 1));
+                }
+                measures.control[v] = control;
+                measures.controllability[v] =
+                    static_cast<double>(numSeen + 1) / static_cast<double>(numReached);
+
+                for (size_t w = firstWord; w <= lastWord; w++) {
+                    seen[w] = 0;
+                }
+                std::fill(reach.begin(), reach.end(), 0);
+            }
+        });
+        return measures;
+    }
+
+} // namespace depthmapX
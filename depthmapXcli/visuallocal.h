@@ -0,0 +1,42 @@
+// SPDX-FileCopyrightText: 2026 depthmapX authors
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#pragma once
+
+// Local measures of a visibility graph, all made of the intersections and
+// unions of the neighbourhoods of the neighbours of each cell. The
+// neighbourhood of a cell is kept as a bitset over all cells while its
+// neighbours are visited, and each neighbour is either walked cell by cell or,
+// if it sees as many cells as there are words in a bitset, combined with it a
+// word at a time from a bitset of its own. Those bitsets are made for the
+// cells that see the most first, up to a cap on the memory they take
+
+#include "csrgraph.h"
+
+#include <vector>
+
+namespace depthmapX {
+
+    // the memory the neighbour bitsets may take by default
+    static constexpr size_t VISUAL_LOCAL_BITSET_BYTES = size_t(256) << 20;
+
+    struct VisualLocalMeasures {
+        // the share of the pairs of cells seen from a cell that see each
+        // other, -1 where fewer than two cells are seen
+        std::vector<double> clustering;
+        // the sum over the cells seen of one over the number of cells each
+        // of them sees (counting itself), -1 where nothing is seen
+        std::vector<double> control;
+        // the cells seen (counting itself) over the cells seen by any of
+        // them, -1 where nothing is seen
+        std::vector<double> controllability;
+    };
+
+    // The edges of the graph are taken as the cells seen from each node,
+    // ignoring duplicates and the node itself. The cells are spread over the
+    // global task scheduler
+    VisualLocalMeasures visualLocalMeasures(const CsrGraph &graph,
+                                            size_t maxBitsetBytes = VISUAL_LOCAL_BITSET_BYTES);
+
+} // namespace depthmapX
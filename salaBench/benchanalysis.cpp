@@ -0,0 +1,81 @@
+// SPDX-FileCopyrightText: 2026 depthmapX authors
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "benchmark.h"
+
+#include "depthmapXcli/dxinterface/metagraphdx.h"
+
+#include "salalib/genlib/exceptions.h"
+
+#include <memory>
+
+namespace {
+    // a graph from testdata as the cli loads it, the analyses run on its
+    // displayed map
+    std::unique_ptr<MetaGraphDX> loadTestDataGraph(const std::string &name) {
+        std::unique_ptr<MetaGraphDX> metaGraph(new MetaGraphDX("Benchmark graph"));
+        metaGraph->readFromFile(salabench::testDataFile(name));
+        if (metaGraph->getReadStatus() != MetaGraphReadWrite::ReadStatus::OK) {
+            throw depthmapX::RuntimeException("Failed to load the benchmark graph " + name);
+        }
+        return metaGraph;
+    }
+
+    void benchmarkVga(salabench::State &state, const Options &options) {
+        auto metaGraph = loadTestDataGraph("gallery_connected.graph");
+        while (state.keepRunning()) {
+            metaGraph->analyseGraph(nullptr, options, true);
+        }
+        state.setItemsPerOp(metaGraph->getDisplayedPointMap().getAttributeTable().getNumRows());
+    }
+} // namespace
+
+SALA_BENCHMARK(vgaVisual, "VGA visibility global and local") {
+    Options options;
+    options.outputType = AnalysisType::VISUAL;
+    options.global = true;
+    options.local = true;
+    options.radius = -1;
+    benchmarkVga(state, options);
+}
+
+SALA_BENCHMARK(vgaMetric, "VGA metric") {
+    Options options;
+    options.outputType = AnalysisType::METRIC;
+    options.radius = -1;
+    benchmarkVga(state, options);
+}
+
+SALA_BENCHMARK(vgaAngular, "VGA angular") {
+    Options options;
+    options.outputType = AnalysisType::ANGULAR;
+    benchmarkVga(state, options);
+}
+
+SALA_BENCHMARK(axialIntegration, "Axial integration and choice") {
+    auto metaGraph = loadTestDataGraph("barnsbury_axial.graph");
+    Options options;
+    options.radiusSet.insert(-1);
+    options.choice = true;
+    options.local = true;
+    options.weightedMeasureCol = -1;
+    while (state.keepRunning()) {
+        metaGraph->analyseAxial(nullptr, options, false);
+    }
+    state.setItemsPerOp(metaGraph->getDisplayedShapeGraph().getAttributeTable().getNumRows());
+}
+
+SALA_BENCHMARK(segmentTulip, "Segment tulip integration and choice") {
+    auto metaGraph = loadTestDataGraph("barnsbury_segment.graph");
+    Options options;
+    options.radiusSet.insert(-1);
+    options.choice = true;
+    options.tulipBins = 1024;
+    options.weightedMeasureCol = -1;
+    options.radiusType = RadiusType::ANGULAR;
+    while (state.keepRunning()) {
+        metaGraph->analyseSegmentsTulip(nullptr, options, false);
+    }
+    state.setItemsPerOp(metaGraph->getDisplayedShapeGraph().getAttributeTable().getNumRows());
+}
@@ -0,0 +1,67 @@
+// SPDX-FileCopyrightText: 2026 depthmapX authors
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "benchmark.h"
+
+#include "salalib/attributetable.h"
+#include "salalib/attributetableindex.h"
+
+#include <string>
+
+namespace {
+    const size_t NUM_ROWS = 20000;
+    const size_t NUM_COLUMNS = 8;
+
+    void fillTable(AttributeTable &table) {
+        for (size_t col = 0; col < NUM_COLUMNS; col++) {
+            table.getOrInsertColumn("col" + std::to_string(col));
+        }
+        for (size_t row = 0; row < NUM_ROWS; row++) {
+            auto &tableRow = table.addRow(AttributeKey(static_cast<int>(row)));
+            for (size_t col = 0; col < NUM_COLUMNS; col++) {
+                // a spread of values that is not already sorted
+                tableRow.setValue(col, static_cast<float>((row * 7919 + col) % NUM_ROWS));
+            }
+        }
+    }
+} // namespace
+
+SALA_BENCHMARK(attributeTableFill, "AttributeTable fill") {
+    while (state.keepRunning()) {
+        AttributeTable table;
+        fillTable(table);
+    }
+    state.setItemsPerOp(NUM_ROWS * NUM_COLUMNS);
+}
+
+SALA_BENCHMARK(attributeTableResetColumn, "AttributeTable reset and fill column") {
+    AttributeTable table;
+    fillTable(table);
+    while (state.keepRunning()) {
+        size_t col = table.insertOrResetColumn("col3");
+        for (size_t row = 0; row < NUM_ROWS; row++) {
+            table.getRow(AttributeKey(static_cast<int>(row))).setValue(col, 1.0f);
+        }
+    }
+    state.setItemsPerOp(NUM_ROWS);
+}
+
+SALA_BENCHMARK(attributeTableAddRemoveColumn, "AttributeTable add and remove column") {
+    AttributeTable table;
+    fillTable(table);
+    while (state.keepRunning()) {
+        size_t col = table.getOrInsertColumn("scratch");
+        table.removeColumn(col);
+    }
+    state.setItemsPerOp(NUM_ROWS);
+}
+
+SALA_BENCHMARK(makeAttributeIndexBenchmark, "makeAttributeIndex") {
+    AttributeTable table;
+    fillTable(table);
+    while (state.keepRunning()) {
+        auto index = makeAttributeIndex(table, 0);
+    }
+    state.setItemsPerOp(NUM_ROWS);
+}
@@ -0,0 +1,22 @@
+// SPDX-FileCopyrightText: 2026 depthmapX authors
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "benchmark.h"
+
+#include "salalib/entityparsing.h"
+
+#include <fstream>
+#include <iterator>
+#include <sstream>
+
+SALA_BENCHMARK(entityParsingLines, "EntityParsing::parseLines") {
+    std::ifstream file(salabench::testDataFile("barnsbury_extended1_axial.tsv"));
+    std::string content((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+    size_t numLines = 0;
+    while (state.keepRunning()) {
+        std::stringstream stream(content);
+        numLines = EntityParsing::parseLines(stream, '\t').size();
+    }
+    state.setItemsPerOp(numLines);
+}
@@ -0,0 +1,46 @@
+// SPDX-FileCopyrightText: 2026 depthmapX authors
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "benchmark.h"
+
+#include "salalib/genlib/bsptree.h"
+#include "salalib/sparksieve2.h"
+
+#include <algorithm>
+#include <memory>
+
+SALA_BENCHMARK(bspTreeMake, "BSPTree::make") {
+    std::vector<Line> lines = salabench::testDataLines();
+    while (state.keepRunning()) {
+        std::unique_ptr<BSPNode> node(new BSPNode());
+        BSPTree::make(nullptr, 0, lines, node.get());
+    }
+    state.setItemsPerOp(lines.size());
+}
+
+SALA_BENCHMARK(sparkSieveBlock, "sparkSieve2::block") {
+    // the lines wholly below and left of the centre of the map, the quadrant
+    // q = 4 looks into
+    const auto &allLines = salabench::testDataLines();
+    Point2f centre(0, 0);
+    for (const auto &line : allLines) {
+        centre.x += (line.ax() + line.bx()) / 2;
+        centre.y += (line.ay() + line.by()) / 2;
+    }
+    centre.x /= static_cast<double>(allLines.size());
+    centre.y /= static_cast<double>(allLines.size());
+    std::vector<Line> lines;
+    for (const auto &line : allLines) {
+        if (std::max(line.ax(), line.bx()) < centre.x &&
+            std::max(line.ay(), line.by()) < centre.y) {
+            lines.push_back(line);
+        }
+    }
+    while (state.keepRunning()) {
+        sparkSieve2 sieve(centre);
+        sieve.block(lines, 4);
+        sieve.collectgarbage();
+    }
+    state.setItemsPerOp(lines.size());
+}
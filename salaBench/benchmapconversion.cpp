@@ -0,0 +1,57 @@
+// SPDX-FileCopyrightText: 2026 depthmapX authors
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "benchmark.h"
+
+#include "salalib/mapconverter.h"
+#include "salalib/shapegraph.h"
+#include "salalib/shapemapgroupdata.h"
+
+namespace {
+    typedef std::vector<std::pair<ShapeMapGroupData, std::vector<ShapeMap>>> DrawingFiles;
+
+    // the barnsbury axial lines as one drawing layer
+    void makeDrawing(DrawingFiles &drawingFiles) {
+        drawingFiles.resize(1);
+        drawingFiles.back().first.name = "Benchmark drawing";
+        auto &spacePixels = drawingFiles.back().second;
+        spacePixels.emplace_back("Drawing layer", ShapeMap::DRAWINGMAP);
+        for (const auto &line : salabench::testDataLines()) {
+            spacePixels.back().makeLineShape(line);
+        }
+    }
+} // namespace
+
+SALA_BENCHMARK(convertDrawingToAxial, "MapConverter::convertDrawingToAxial") {
+    DrawingFiles drawingFiles;
+    makeDrawing(drawingFiles);
+    auto drawingMapRefs = ShapeMapGroupData::getAsRefMaps(drawingFiles);
+    while (state.keepRunning()) {
+        auto axialMap = MapConverter::convertDrawingToAxial(nullptr, "Axial map", drawingMapRefs);
+    }
+    state.setItemsPerOp(salabench::testDataLines().size());
+}
+
+SALA_BENCHMARK(convertDrawingToSegment, "MapConverter::convertDrawingToSegment") {
+    DrawingFiles drawingFiles;
+    makeDrawing(drawingFiles);
+    auto drawingMapRefs = ShapeMapGroupData::getAsRefMaps(drawingFiles);
+    while (state.keepRunning()) {
+        auto segmentMap =
+            MapConverter::convertDrawingToSegment(nullptr, "Segment map", drawingMapRefs);
+    }
+    state.setItemsPerOp(salabench::testDataLines().size());
+}
+
+SALA_BENCHMARK(convertAxialToSegment, "MapConverter::convertAxialToSegment") {
+    DrawingFiles drawingFiles;
+    makeDrawing(drawingFiles);
+    auto drawingMapRefs = ShapeMapGroupData::getAsRefMaps(drawingFiles);
+    auto axialMap = MapConverter::convertDrawingToAxial(nullptr, "Axial map", drawingMapRefs);
+    while (state.keepRunning()) {
+        auto segmentMap =
+            MapConverter::convertAxialToSegment(nullptr, *axialMap.get(), "Segment map", true);
+    }
+    state.setItemsPerOp(salabench::testDataLines().size());
+}
@@ -0,0 +1,142 @@
+// SPDX-FileCopyrightText: 2026 depthmapX authors
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "benchmark.h"
+
+#include "salalib/entityparsing.h"
+#include "salalib/genlib/exceptions.h"
+
+#include <atomic>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <new>
+
+namespace {
+    std::atomic<size_t> allocations(0);
+
+    std::vector<std::pair<std::string, salabench::BenchmarkFunction>> &registry() {
+        static std::vector<std::pair<std::string, salabench::BenchmarkFunction>> benchmarks;
+        return benchmarks;
+    }
+
+    std::string jsonString(const std::string &text) {
+        std::string quoted = "\"";
+        for (char c : text) {
+            if (c == '"' || c == '\\') {
+                quoted += '\\';
+            }
+            quoted += c;
+        }
+        return quoted + "\"";
+    }
+} // namespace
+
+// counts the allocations of the benchmarked code
+void *operator new(std::size_t size) {
+    allocations.fetch_add(1, std::memory_order_relaxed);
+    if (void *memory = std::malloc(size == 0 ? 1 : size)) {
+        return memory;
+    }
+    throw std::bad_alloc();
+}
+
+void *operator new[](std::size_t size) { return operator new(size); }
+
+void operator delete(void *memory) noexcept { std::free(memory); }
+
+void operator delete[](void *memory) noexcept { std::free(memory); }
+
+void operator delete(void *memory, std::size_t) noexcept { std::free(memory); }
+
+void operator delete[](void *memory, std::size_t) noexcept { std::free(memory); }
+
+namespace salabench {
+
+    bool State::keepRunning() {
+        if (!m_running) {
+            m_running = true;
+            m_iterations = 0;
+            m_startAllocations = allocationCount();
+            m_start = Clock::now();
+            return true;
+        }
+        m_iterations++;
+        double elapsed = std::chrono::duration<double>(Clock::now() - m_start).count();
+        if (elapsed < m_minSeconds) {
+            return true;
+        }
+        m_seconds = elapsed;
+        m_allocations = allocationCount() - m_startAllocations;
+        m_running = false;
+        return false;
+    }
+
+    bool add(const std::string &name, BenchmarkFunction function) {
+        registry().emplace_back(name, function);
+        return true;
+    }
+
+    std::vector<std::string> names() {
+        std::vector<std::string> names;
+        for (const auto &benchmark : registry()) {
+            names.push_back(benchmark.first);
+        }
+        return names;
+    }
+
+    std::vector<Result> run(const std::string &filter, double minSeconds) {
+        std::vector<Result> results;
+        for (const auto &benchmark : registry()) {
+            if (benchmark.first.find(filter) == std::string::npos) {
+                continue;
+            }
+            std::cerr << benchmark.first << "..." << std::flush;
+            State state(minSeconds);
+            benchmark.second(state);
+            if (state.iterations() == 0) {
+                throw depthmapX::RuntimeException("Benchmark " + benchmark.first +
+                                                  " did not run its operation");
+            }
+            double ops = static_cast<double>(state.iterations());
+            Result result{benchmark.first, state.iterations(), state.seconds() * 1e9 / ops,
+                          static_cast<double>(state.itemsPerOp()) * ops / state.seconds(),
+                          static_cast<double>(state.allocations()) / ops};
+            std::cerr << " " << result.nsPerOp << " ns/op\n" << std::flush;
+            results.push_back(result);
+        }
+        return results;
+    }
+
+    void writeJson(std::ostream &stream, const std::vector<Result> &results) {
+        stream << "{\n  \"benchmarks\": [";
+        for (size_t i = 0; i < results.size(); i++) {
+            const Result &result = results[i];
+            stream << (i == 0 ? "\n" : ",\n") << "    {\"name\": " << jsonString(result.name)
+                   << ", \"iterations\": " << result.iterations
+                   << ", \"nsPerOp\": " << result.nsPerOp
+                   << ", \"itemsPerSecond\": " << result.itemsPerSecond
+                   << ", \"allocationsPerOp\": " << result.allocationsPerOp << "}";
+        }
+        stream << "\n  ]\n}\n" << std::flush;
+    }
+
+    size_t allocationCount() { return allocations.load(std::memory_order_relaxed); }
+
+    std::string testDataFile(const std::string &name) {
+        return std::string(SALABENCH_TESTDATA) + "/" + name;
+    }
+
+    const std::vector<Line> &testDataLines() {
+        static const std::vector<Line> lines = [] {
+            std::ifstream stream(testDataFile("barnsbury_extended1_axial.tsv"));
+            if (!stream) {
+                throw depthmapX::RuntimeException("Failed to open the benchmark test data");
+            }
+            return EntityParsing::parseLines(stream, '\t');
+        }();
+        return lines;
+    }
+
+} // namespace salabench
@@ -0,0 +1,88 @@
+// SPDX-FileCopyrightText: 2026 depthmapX authors
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#pragma once
+
+// A small benchmark harness for salalib. Benchmarks are functions registered
+// with SALA_BENCHMARK that prepare their inputs and then repeat the operation
+// they measure for as long as State::keepRunning returns true:
+//
+//     SALA_BENCHMARK(parseLines, "EntityParsing::parseLines") {
+//         ... prepare ...
+//         while (state.keepRunning()) {
+//             ... operation ...
+//         }
+//         state.setItemsPerOp(numLines);
+//     }
+
+#include "salalib/genlib/p2dpoly.h"
+
+#include <chrono>
+#include <cstddef>
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace salabench {
+
+    class State {
+      public:
+        explicit State(double minSeconds) : m_minSeconds(minSeconds) {}
+
+        // true while the operation is to be run again. The operation is
+        // repeated for at least the minimum time
+        bool keepRunning();
+        // the number of items (lines, rows...) one operation processes, for
+        // the throughput
+        void setItemsPerOp(size_t items) { m_itemsPerOp = items; }
+
+        size_t iterations() const { return m_iterations; }
+        double seconds() const { return m_seconds; }
+        size_t allocations() const { return m_allocations; }
+        size_t itemsPerOp() const { return m_itemsPerOp; }
+
+      private:
+        typedef std::chrono::steady_clock Clock;
+
+        double m_minSeconds;
+        bool m_running = false;
+        size_t m_iterations = 0;
+        double m_seconds = 0;
+        size_t m_allocations = 0;
+        size_t m_startAllocations = 0;
+        size_t m_itemsPerOp = 1;
+        Clock::time_point m_start;
+    };
+
+    typedef void (*BenchmarkFunction)(State &);
+
+    struct Result {
+        std::string name;
+        size_t iterations;
+        double nsPerOp;
+        double itemsPerSecond;
+        double allocationsPerOp;
+    };
+
+    // returns true so that it can initialise a static
+    bool add(const std::string &name, BenchmarkFunction function);
+    std::vector<std::string> names();
+    // runs the benchmarks whose names contain the filter
+    std::vector<Result> run(const std::string &filter, double minSeconds);
+    void writeJson(std::ostream &stream, const std::vector<Result> &results);
+
+    // the number of allocations made through operator new so far
+    size_t allocationCount();
+
+    // the lines of the barnsbury axial map in testdata, the common input of
+    // the geometric benchmarks
+    const std::vector<Line> &testDataLines();
+    std::string testDataFile(const std::string &name);
+
+} // namespace salabench
+
+#define SALA_BENCHMARK(function, name)                                                             \
+    static void function(salabench::State &state);                                                 \
+    [[maybe_unused]] static const bool function##Registered = salabench::add(name, &function);     \
+    static void function(salabench::State &state)
@@ -0,0 +1,63 @@
+// SPDX-FileCopyrightText: 2026 depthmapX authors
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "benchmark.h"
+
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+
+namespace {
+    void printHelp() {
+        std::cout << "Usage: salaBench [-b <filter>] [-o <results.json>] [-mt <seconds>] [-l]\n"
+                  << "-b <filter> only runs the benchmarks whose names contain the filter\n"
+                  << "-o <results.json> writes the results to the given file instead of the\n"
+                  << "   standard output\n"
+                  << "-mt <seconds> minimum time to repeat each benchmark for, default 1\n"
+                  << "-l lists the benchmarks\n"
+                  << "Results give the time per operation in ns, the items (lines, rows...)\n"
+                  << "processed per second and the allocations per operation\n"
+                  << std::flush;
+    }
+} // namespace
+
+int main(int argc, char *argv[]) {
+    std::string filter;
+    std::string outputFile;
+    double minSeconds = 1;
+    for (int i = 1; i < argc; i++) {
+        bool hasValue = i + 1 < argc;
+        if (std::strcmp("-b", argv[i]) == 0 && hasValue) {
+            filter = argv[++i];
+        } else if (std::strcmp("-o", argv[i]) == 0 && hasValue) {
+            outputFile = argv[++i];
+        } else if (std::strcmp("-mt", argv[i]) == 0 && hasValue) {
+            minSeconds = std::atof(argv[++i]);
+        } else if (std::strcmp("-l", argv[i]) == 0) {
+            for (const auto &name : salabench::names()) {
+                std::cout << name << "\n";
+            }
+            std::cout << std::flush;
+            return 0;
+        } else {
+            printHelp();
+            return std::strcmp("-h", argv[i]) == 0 ? 0 : -1;
+        }
+    }
+
+    try {
+        auto results = salabench::run(filter, minSeconds);
+        if (outputFile.empty()) {
+            salabench::writeJson(std::cout, results);
+        } else {
+            std::ofstream stream(outputFile);
+            salabench::writeJson(stream, results);
+        }
+    } catch (std::exception &e) {
+        std::cerr << e.what() << std::endl;
+        return -1;
+    }
+    return 0;
+}